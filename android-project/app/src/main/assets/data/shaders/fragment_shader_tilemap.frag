@@ -0,0 +1,30 @@
+#ifdef GL_ES
+precision highp float;
+precision highp sampler2D;
+precision mediump sampler2DArray;
+#endif
+
+in vec2 tilePosition;
+
+out vec4 fragColor;
+
+uniform sampler2D tiles;
+uniform sampler2DArray tileset;
+
+void main()
+{
+    // Only the edges of the quad can round outside the grid.
+    ivec2 tile = ivec2(floor(tilePosition));
+    if (any(lessThan(tile, ivec2(0))) || any(greaterThanEqual(tile, textureSize(tiles, 0))))
+        discard;
+
+    int id = int(texelFetch(tiles, tile, 0).r * 255.0 + 0.5);
+    if (id == 0) discard;
+
+    // Rows of tile images go from top to bottom.
+    vec2 texCoord = vec2(fract(tilePosition.x), 1.0 - fract(tilePosition.y));
+    vec4 color = texture(tileset, vec3(texCoord, float(id - 1)));
+    if (color.a == 0.0) discard;
+
+    fragColor = color;
+}
\ No newline at end of file
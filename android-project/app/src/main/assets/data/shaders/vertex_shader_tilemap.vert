@@ -0,0 +1,20 @@
+layout(location = 0) in vec2 vertPosition;
+
+out vec2 tilePosition;
+
+uniform mat3 matrix;
+uniform vec2 gridSize;
+uniform float depth;
+
+layout(std140) uniform Camera
+{
+    mat3 viewMatrix;
+    vec2 screenSize;
+};
+
+void main()
+{
+    // The unit quad stretched over the [0, columns] x [0, rows] rectangle of the tile space.
+    tilePosition = (vertPosition + 0.5) * gridSize;
+    gl_Position = vec4((viewMatrix * matrix * vec3(tilePosition, 1.0)).xy, depth, 1.0);
+}
\ No newline at end of file
@@ -3,6 +3,7 @@ precision highp float;
 #endif
 
 in vec2 texCoord;
+in vec4 tint;
 
 out vec4 fragColor;
 
@@ -13,5 +14,5 @@ void main()
     vec4 color = texture(texSampler, texCoord);
     if (color.a == 0.0) discard;
 
-    fragColor = color;
+    fragColor = color * tint;
 }
\ No newline at end of file
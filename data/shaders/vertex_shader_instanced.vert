@@ -0,0 +1,26 @@
+layout(location = 0) in vec2 vertPosition;
+layout(location = 1) in vec2 vertTexCoord;
+layout(location = 2) in vec4 vertColor;
+layout(location = 3) in vec2 instanceOffset;
+layout(location = 4) in vec2 instanceTexOffset;
+layout(location = 5) in vec4 instanceTint;
+
+out vec2 texCoord;
+out vec4 tint;
+
+uniform mat3 matrix;
+uniform float depth;
+
+layout(std140) uniform Camera
+{
+    mat3 viewMatrix;
+    vec2 screenSize;
+};
+
+void main()
+{
+    texCoord = vertTexCoord + instanceTexOffset;
+    tint = vec4(instanceTint.rgb * instanceTint.a, instanceTint.a);
+    vec3 pos = viewMatrix * matrix * vec3(vertPosition + instanceOffset, 1.0);
+    gl_Position = vec4(pos.x, pos.y, depth, 1.0);
+}
\ No newline at end of file
@@ -3,12 +3,21 @@ layout(location = 1) in vec2 vertTexCoord;
 layout(location = 2) in vec4 vertColor;
 
 out vec2 texCoord;
+out vec4 tint;
 
 uniform mat3 matrix;
+uniform float depth;
+
+layout(std140) uniform Camera
+{
+    mat3 viewMatrix;
+    vec2 screenSize;
+};
 
 void main()
 {
     texCoord = vertTexCoord;
+    tint = vec4(1.0);
     vec3 pos = matrix * vec3(vertPosition, 1.0);
-    gl_Position = vec4(pos.x, pos.y, 0.0, 1.0);
+    gl_Position = vec4(pos.x, pos.y, depth, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifdef GL_ES
+precision highp float;
+#endif
+
+in vec2 texCoord;
+in vec4 tint;
+
+out vec4 fragColor;
+
+uniform sampler2D texSampler;
+
+// Opaque draws never discard, so the depth test can run before shading.
+void main()
+{
+    fragColor = vec4(texture(texSampler, texCoord).rgb * tint.rgb, 1.0);
+}
\ No newline at end of file
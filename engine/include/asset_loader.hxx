@@ -0,0 +1,153 @@
+#ifndef ENGINE_PREPARE_TO_GAME_ASSET_LOADER_HXX
+#define ENGINE_PREPARE_TO_GAME_ASSET_LOADER_HXX
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "audio.hxx"
+#include "texture.hxx"
+
+namespace fs = std::filesystem;
+
+class FileReader;
+
+// Loads textures and sounds without stalling the frame. Files requested between
+// two submit() calls are read as one batch, with io_uring where the engine is
+// built with it, and each file goes to the worker threads for decoding as soon as
+// it is read. Files in the packs mounted in AssetRegistry skip the read and are
+// decoded straight from the pack, so the packs must stay mounted while the loader
+// is busy. Decoded pixels wait until update(), called on the GL thread once a
+// frame, uploads as many as fit in the time budget. Handles are usable at
+// once: the texture of a handle shows a transparent placeholder until its pixels
+// are uploaded, and a sound played early starts once it is loaded. The loader
+// must outlive the use of its handles.
+class AssetLoader final
+{
+public:
+    enum class Status
+    {
+        loading,
+        ready,
+        failed
+    };
+
+private:
+    struct TextureState
+    {
+        Texture texture{};
+        std::atomic<Status> status{ Status::loading };
+        std::string error{};
+    };
+
+    using ReadJob = std::function<void(std::span<const std::byte> data, std::exception_ptr error)>;
+
+    struct AudioState
+    {
+        std::mutex mutex{};
+        std::unique_ptr<Audio> audio{};
+        // Loop flag of a play() that came before the sound was loaded.
+        std::optional<bool> pendingPlay{};
+        std::atomic<Status> status{ Status::loading };
+        std::string error{};
+    };
+
+public:
+    class TextureHandle final
+    {
+    private:
+        std::shared_ptr<TextureState> m_state{};
+
+    public:
+        TextureHandle() = default;
+
+        // The same object before and after the upload, so sprites may keep it.
+        [[nodiscard]] Texture& getTexture() const;
+        [[nodiscard]] Status getStatus() const;
+        [[nodiscard]] bool isReady() const;
+        // Why the texture failed to load.
+        [[nodiscard]] const std::string& getError() const;
+
+    private:
+        explicit TextureHandle(std::shared_ptr<TextureState> state);
+
+        friend class AssetLoader;
+    };
+
+    class AudioHandle final
+    {
+    private:
+        std::shared_ptr<AudioState> m_state{};
+
+    public:
+        AudioHandle() = default;
+
+        void play(bool isLooped = false);
+        [[nodiscard]] Status getStatus() const;
+        [[nodiscard]] bool isReady() const;
+        [[nodiscard]] const std::string& getError() const;
+
+    private:
+        explicit AudioHandle(std::shared_ptr<AudioState> state);
+
+        friend class AssetLoader;
+    };
+
+private:
+    Texture m_placeholder{};
+    std::chrono::microseconds m_uploadBudget{};
+
+    std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+    std::deque<std::function<void()>> m_jobs{};
+    // Decoded textures waiting for their upload on the GL thread.
+    std::deque<std::pair<std::shared_ptr<TextureState>, PixelData>> m_decoded{};
+    bool m_isStopping{};
+    std::atomic<std::size_t> m_pendingCount{};
+
+    std::vector<std::thread> m_workers{};
+    std::unique_ptr<FileReader> m_reader{};
+
+public:
+    explicit AssetLoader(
+        std::size_t threadCount = 2,
+        std::chrono::microseconds uploadBudget = std::chrono::microseconds{ 2000 });
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    [[nodiscard]] TextureHandle loadTexture(const fs::path& path);
+    [[nodiscard]] AudioHandle loadAudio(const fs::path& path);
+
+    // Starts reading the files requested since the last call as one batch.
+    void submit();
+
+    // Submits the requested files, then uploads decoded textures until the budget is
+    // spent, at least one a call. Returns the number of textures uploaded.
+    std::size_t update();
+
+    // No asset is being read, decoded or waiting for its upload.
+    [[nodiscard]] bool isIdle() const noexcept;
+
+private:
+    void addRead(const fs::path& path, ReadJob job);
+    void addPacked(std::span<const std::byte> file, ReadJob job);
+    void addJob(std::function<void()> job);
+    void run();
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_ASSET_LOADER_HXX
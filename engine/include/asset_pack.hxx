@@ -0,0 +1,77 @@
+#ifndef ENGINE_PREPARE_TO_GAME_ASSET_PACK_HXX
+#define ENGINE_PREPARE_TO_GAME_ASSET_PACK_HXX
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.hxx"
+
+namespace fs = std::filesystem;
+
+// Asset packs: many files in one, written by tools/asset_packer. Values are
+// little-endian. An AssetPackHeader is followed by entryCount AssetPackEntry
+// records sorted by name, then the names, then the file contents, each starting
+// at a multiple of asset_pack_alignment from the start of the pack. Names are
+// the normalised paths the files are loaded by, e.g. "data/assets/coin.png".
+
+inline constexpr std::array<char, 4> asset_pack_magic{ 'P', 'P', 'A', 'K' };
+inline constexpr std::uint32_t asset_pack_version{ 1 };
+inline constexpr std::size_t asset_pack_alignment{ 16 };
+
+struct AssetPackHeader
+{
+    std::array<char, 4> magic{};
+    std::uint32_t version{};
+    std::uint32_t entryCount{};
+    std::uint32_t reserved{};
+    // Offset of the names from the start of the pack.
+    std::uint64_t namesOffset{};
+    std::uint64_t namesSize{};
+};
+
+struct AssetPackEntry
+{
+    std::uint64_t offset{};
+    std::uint64_t size{};
+    // Offset of the name from the start of the names.
+    std::uint32_t nameOffset{};
+    std::uint32_t nameSize{};
+};
+
+static_assert(sizeof(AssetPackHeader) == 32);
+static_assert(sizeof(AssetPackEntry) == 24);
+
+// Reader of an asset pack mapped once into memory. The table of contents is
+// checked on opening; lookups are a binary search and return views into the
+// mapping, valid as long as the pack.
+class AssetPack final
+{
+private:
+    struct Entry
+    {
+        std::string_view name{};
+        std::span<const std::byte> data{};
+    };
+
+    MappedFile m_file;
+    std::vector<Entry> m_entries{};
+
+public:
+    explicit AssetPack(const fs::path& path);
+
+    [[nodiscard]] std::optional<std::span<const std::byte>>
+    find(std::string_view name) const noexcept;
+    // Like find but throws when the pack has no such file.
+    [[nodiscard]] std::span<const std::byte> get(std::string_view name) const;
+    [[nodiscard]] bool contains(std::string_view name) const noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_ASSET_PACK_HXX
@@ -0,0 +1,75 @@
+#ifndef ENGINE_PREPARE_TO_GAME_ASSET_REGISTRY_HXX
+#define ENGINE_PREPARE_TO_GAME_ASSET_REGISTRY_HXX
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "asset_pack.hxx"
+#include "audio.hxx"
+#include "texture.hxx"
+
+namespace fs = std::filesystem;
+
+// Textures and sounds shared by path, so every file is decoded once and held in
+// VRAM once however many sprites use it. Paths are normalised before lookup, so
+// "data/./a.png" and "data/a.png" are the same asset. The registry keeps a
+// reference to every resource until it is evicted; users keep theirs, so an
+// evicted resource lives until its last user is gone. Files are looked up in the
+// mounted asset packs before the file system, and other loaders find theirs there
+// too. Used on the GL thread.
+class AssetRegistry final
+{
+private:
+    std::unordered_map<std::string, std::shared_ptr<const Texture>> m_textures{};
+    std::unordered_map<std::string, std::shared_ptr<Audio>> m_sounds{};
+    std::vector<AssetPack> m_packs{};
+
+    AssetRegistry() = default;
+
+public:
+    static AssetRegistry& getInstance();
+
+    AssetRegistry(const AssetRegistry&) = delete;
+    AssetRegistry& operator=(const AssetRegistry&) = delete;
+
+    // Later packs take precedence over earlier ones. Resources loaded before
+    // stay as they are until evicted.
+    void mount(const fs::path& packPath);
+
+    // Loads the file on the first request, later requests share the resource.
+    [[nodiscard]] std::shared_ptr<const Texture> getTexture(const fs::path& path);
+    [[nodiscard]] std::shared_ptr<Audio> getAudio(const fs::path& path);
+
+    // Contents of the file in the mounted packs, valid until clear() unmounts them.
+    [[nodiscard]] std::optional<std::span<const std::byte>>
+    findInPacks(const fs::path& path) const;
+    // Like findInPacks, but takes the cooked texture of the image when packed.
+    [[nodiscard]] std::optional<std::span<const std::byte>>
+    findImageInPacks(const fs::path& path) const;
+    // Decodes the image from the packs, or from the file system when no pack has it.
+    [[nodiscard]] PixelData readImage(const fs::path& path) const;
+
+    // Drops the registry's reference to the resources of the path.
+    bool evict(const fs::path& path);
+    // Drops the resources nobody but the registry uses and returns how many.
+    std::size_t evictUnused();
+    // Drops every resource and unmounts the packs.
+    void clear();
+
+    [[nodiscard]] std::size_t getTextureCount() const noexcept;
+    [[nodiscard]] std::size_t getAudioCount() const noexcept;
+
+private:
+    [[nodiscard]] std::optional<std::span<const std::byte>>
+    findPacked(std::string_view name) const;
+    [[nodiscard]] static std::string normalize(const fs::path& path);
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_ASSET_REGISTRY_HXX
@@ -0,0 +1,99 @@
+#ifndef ENGINE_PREPARE_TO_GAME_ATLAS_HXX
+#define ENGINE_PREPARE_TO_GAME_ATLAS_HXX
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "structures.hxx"
+#include "texture.hxx"
+
+namespace fs = std::filesystem;
+
+// Textures packed by AtlasBuilder. Pages own the GL textures, every packed image
+// is a non-owning Texture view of its region on one of them.
+class Atlas final
+{
+private:
+    std::vector<std::unique_ptr<Texture>> m_pages{};
+    std::unordered_map<std::string, std::unique_ptr<Texture>> m_textures{};
+
+public:
+    Atlas() = default;
+
+    Atlas(const Atlas&) = delete;
+    Atlas& operator=(const Atlas&) = delete;
+    Atlas(Atlas&&) = default;
+    Atlas& operator=(Atlas&&) = default;
+
+    [[nodiscard]] Texture& getTexture(std::string_view name);
+    [[nodiscard]] bool contains(std::string_view name) const;
+    [[nodiscard]] std::size_t getPageCount() const noexcept;
+
+    friend class AtlasBuilder;
+};
+
+// Packs images into as few pages as possible with a skyline bottom-left packer.
+// Every image is surrounded by padding filled with its own edge pixels, so
+// linear filtering never samples a neighbour.
+class AtlasBuilder final
+{
+private:
+    struct Image
+    {
+        std::string name{};
+        PixelData data{};
+    };
+
+    struct SkylineNode
+    {
+        std::size_t x{};
+        std::size_t y{};
+        std::size_t width{};
+    };
+
+    struct Placement
+    {
+        std::size_t x{};
+        std::size_t y{};
+        std::size_t node{};
+    };
+
+    struct Page
+    {
+        std::vector<SkylineNode> skyline{};
+        std::vector<std::uint8_t> pixels{};
+    };
+
+    std::size_t m_pageWidth{};
+    std::size_t m_pageHeight{};
+    std::size_t m_padding{};
+
+    std::vector<Image> m_images{};
+
+public:
+    explicit AtlasBuilder(std::size_t pageWidth = 1024,
+                          std::size_t pageHeight = 1024,
+                          std::size_t padding = 2);
+
+    void add(std::string name, const fs::path& path);
+    void add(std::string name, PixelData data);
+
+    [[nodiscard]] Atlas build();
+
+private:
+    [[nodiscard]] Page createPage() const;
+    [[nodiscard]] std::optional<Placement>
+    findPlacement(const Page& page, std::size_t width, std::size_t height) const;
+    static void addSkylineLevel(Page& page,
+                                const Placement& placement,
+                                std::size_t width,
+                                std::size_t height);
+    void copyPixels(Page& page, const Image& image, std::size_t x, std::size_t y) const;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_ATLAS_HXX
@@ -1,11 +1,16 @@
 #ifndef ENGINE_PREPARE_TO_GAME_AUDIO_HXX
 #define ENGINE_PREPARE_TO_GAME_AUDIO_HXX
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <span>
 
 using namespace std::literals;
 namespace fs = std::filesystem;
 
+struct SDL_RWops;
+
 class Audio final
 {
 private:
@@ -22,10 +27,16 @@ private:
 
 public:
     explicit Audio(const fs::path& path);
+    // Decodes a WAV file held in memory, e.g. an AssetPack entry.
+    explicit Audio(std::span<const std::byte> file);
     ~Audio();
 
     void play(bool isLooped = false);
 
+private:
+    // Takes ownership of the file and closes it.
+    explicit Audio(SDL_RWops* file);
+
     friend class EngineImpl;
 };
 
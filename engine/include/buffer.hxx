@@ -5,9 +5,12 @@
 #ifndef VERTEX_MORPHING_BUFFER_HXX
 #define VERTEX_MORPHING_BUFFER_HXX
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <memory>
+#include <span>
 #include <vector>
 
 struct Vertex
@@ -31,19 +34,91 @@ struct Vertex2
     std::uint32_t rgba{};
 };
 
+// Per-instance attributes of an instanced draw: offset of the mesh, texture
+// coordinate offset as normalized shorts and a tint color.
+struct Instance2
+{
+    float x{};
+    float y{};
+
+    std::uint16_t texX{};
+    std::uint16_t texY{};
+
+    std::uint32_t rgba{ 0xffffffff };
+
+    bool operator==(const Instance2&) const = default;
+};
+
+// Compile-time description of how the fields of a vertex type feed shader attributes.
+struct VertexAttribute
+{
+    enum class Type
+    {
+        float32,
+        uint8,
+        uint16
+    };
+
+    std::uint32_t index{};
+    std::int32_t size{};
+    Type type{};
+    bool normalized{};
+    std::size_t offset{};
+};
+
+template <typename V>
+struct VertexLayout;
+
+template <>
+struct VertexLayout<Vertex2>
+{
+    inline static constexpr std::uint32_t divisor{ 0 };
+    inline static constexpr std::array attributes{
+        VertexAttribute{ 0, 2, VertexAttribute::Type::float32, false, offsetof(Vertex2, x) },
+        VertexAttribute{ 1, 2, VertexAttribute::Type::float32, false, offsetof(Vertex2, texX) },
+        VertexAttribute{ 2, 4, VertexAttribute::Type::uint8, false, offsetof(Vertex2, rgba) }
+    };
+};
+
+template <>
+struct VertexLayout<Instance2>
+{
+    inline static constexpr std::uint32_t divisor{ 1 };
+    inline static constexpr std::array attributes{
+        VertexAttribute{ 3, 2, VertexAttribute::Type::float32, false, offsetof(Instance2, x) },
+        VertexAttribute{ 4, 2, VertexAttribute::Type::uint16, true, offsetof(Instance2, texX) },
+        VertexAttribute{ 5, 4, VertexAttribute::Type::uint8, true, offsetof(Instance2, rgba) }
+    };
+};
+
 std::ifstream& operator>>(std::ifstream& in, Vertex& vertex);
 std::ifstream& operator>>(std::ifstream& in, Vertex2& vertex);
 
+// How often the contents of a buffer are expected to change: once, now and then
+// or every frame. Streamed buffers are orphaned before a full rewrite so the
+// driver never waits for draws still reading the old contents.
+enum class BufferUsage
+{
+    static_draw,
+    dynamic_draw,
+    stream_draw
+};
+
+// GPU storage grows geometrically, so appending is amortized and partial updates
+// only upload the range that changed.
 template <typename V = Vertex2>
 class VertexBuffer final
 {
 private:
     std::vector<V> m_vertices{};
     std::uint32_t m_vertexBuffer{};
+    std::size_t m_capacity{};
+    BufferUsage m_usage{};
 
 public:
-    explicit VertexBuffer(std::vector<V>&& vertices);
-    explicit VertexBuffer(const std::vector<V>& vertices);
+    explicit VertexBuffer(std::vector<V>&& vertices, BufferUsage usage = BufferUsage::static_draw);
+    explicit VertexBuffer(const std::vector<V>& vertices,
+                          BufferUsage usage = BufferUsage::static_draw);
     ~VertexBuffer();
 
     VertexBuffer(const VertexBuffer&) = delete;
@@ -51,16 +126,24 @@ public:
 
     void updateData(std::vector<V>&& vertices);
     void updateData(const std::vector<V>& vertices);
+    // Overwrites the elements from first on, appending the ones past the end.
+    void updateData(std::size_t first, std::span<const V> vertices);
 
     void addData(std::vector<V>&& vertices);
     void addData(const std::vector<V>& vertices);
 
+    void reserve(std::size_t capacity);
+    void resize(std::size_t size);
     void clear();
     void bind() const;
     [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] std::size_t capacity() const noexcept;
+    [[nodiscard]] const std::vector<V>& getData() const noexcept;
+
+    std::uint32_t operator*() const noexcept;
 
 private:
-    void updateData() const;
+    void upload(std::size_t first, std::size_t count);
 };
 
 template <typename T = std::int16_t>
@@ -69,10 +152,13 @@ class IndexBuffer final
 private:
     std::vector<T> m_indices{};
     std::uint32_t m_indexBuffer{};
+    std::size_t m_capacity{};
+    BufferUsage m_usage{};
 
 public:
-    explicit IndexBuffer(std::vector<T>&& indices);
-    explicit IndexBuffer(const std::vector<T>& indices);
+    explicit IndexBuffer(std::vector<T>&& indices, BufferUsage usage = BufferUsage::static_draw);
+    explicit IndexBuffer(const std::vector<T>& indices,
+                         BufferUsage usage = BufferUsage::static_draw);
     ~IndexBuffer();
 
     IndexBuffer(const IndexBuffer&) = delete;
@@ -80,16 +166,24 @@ public:
 
     void updateData(std::vector<T>&& indices);
     void updateData(const std::vector<T>& indices);
+    // Overwrites the elements from first on, appending the ones past the end.
+    void updateData(std::size_t first, std::span<const T> indices);
 
     void addData(std::vector<T>&& indices);
     void addData(const std::vector<T>& indices);
 
+    void reserve(std::size_t capacity);
+    void resize(std::size_t size);
     void clear();
     void bind() const;
     [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] std::size_t capacity() const noexcept;
+    [[nodiscard]] const std::vector<T>& getData() const noexcept;
+
+    std::uint32_t operator*() const noexcept;
 
 private:
-    void updateData() const;
+    void upload(std::size_t first, std::size_t count);
 };
 
 #endif // VERTEX_MORPHING_BUFFER_HXX
@@ -0,0 +1,67 @@
+#ifndef ENGINE_PREPARE_TO_GAME_COOKED_TEXTURE_HXX
+#define ENGINE_PREPARE_TO_GAME_COOKED_TEXTURE_HXX
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Cooked textures: images decoded ahead of time by tools/texture_cooker, so that
+// loading one is a file mapping and a glTexImage2D per mip level. Values are
+// little-endian. A CookedTextureHeader is followed by the mip levels, level 0
+// first, each getMipWidth x getMipHeight RGBA8 texels with premultiplied alpha,
+// rows from top to bottom. A cooked file sits next to its PNG with the
+// cooked_texture_extension.
+
+inline constexpr std::array<char, 4> cooked_texture_magic{ 'P', 'T', 'E', 'X' };
+inline constexpr std::uint32_t cooked_texture_version{ 1 };
+inline constexpr std::string_view cooked_texture_extension{ ".ctex" };
+
+enum class CookedTextureFormat : std::uint32_t
+{
+    rgba8_premultiplied = 1
+};
+
+struct CookedTextureHeader
+{
+    std::array<char, 4> magic{};
+    std::uint32_t version{};
+    std::uint32_t width{};
+    std::uint32_t height{};
+    CookedTextureFormat format{};
+    std::uint32_t mipCount{};
+    std::array<std::uint32_t, 2> reserved{};
+};
+
+static_assert(sizeof(CookedTextureHeader) == 32);
+
+inline constexpr std::size_t getMipWidth(const CookedTextureHeader& header,
+                                         std::size_t level) noexcept {
+    return header.width >> level > 0 ? header.width >> level : 1;
+}
+
+inline constexpr std::size_t getMipHeight(const CookedTextureHeader& header,
+                                          std::size_t level) noexcept {
+    return header.height >> level > 0 ? header.height >> level : 1;
+}
+
+// Offset of a mip level from the start of the file.
+inline constexpr std::size_t getMipOffset(const CookedTextureHeader& header,
+                                          std::size_t level) noexcept {
+    std::size_t offset{ sizeof(CookedTextureHeader) };
+    for (std::size_t i{}; i < level; ++i)
+        offset += getMipWidth(header, i) * getMipHeight(header, i) * 4;
+
+    return offset;
+}
+
+// Levels down to 1x1 for a full chain.
+inline constexpr std::uint32_t getFullMipCount(std::uint32_t width, std::uint32_t height) noexcept {
+    std::uint32_t count{ 1 };
+    for (auto size{ width > height ? width : height }; size > 1; size >>= 1)
+        ++count;
+
+    return count;
+}
+
+#endif // ENGINE_PREPARE_TO_GAME_COOKED_TEXTURE_HXX
@@ -0,0 +1,64 @@
+#ifndef ENGINE_PREPARE_TO_GAME_DYNAMIC_TEXTURE_HXX
+#define ENGINE_PREPARE_TO_GAME_DYNAMIC_TEXTURE_HXX
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "texture.hxx"
+
+// Small RGBA8 texture with a CPU copy, for images that change a few texels at a
+// time such as fog of war or a minimap. Changed texels are gathered into at most
+// s_maxDirtyRectangles rectangles, each sent with one glTexSubImage2D on upload(),
+// so the cost of a frame follows what changed rather than the texture size.
+// Rows go from top to bottom like PixelData.
+class DynamicTexture final
+{
+public:
+    using Color = std::array<std::uint8_t, 4>;
+
+private:
+    // Half-open ranges of texels.
+    struct DirtyRectangle
+    {
+        std::size_t firstX{};
+        std::size_t lastX{};
+        std::size_t firstY{};
+        std::size_t lastY{};
+    };
+
+    inline static constexpr std::size_t s_maxDirtyRectangles{ 4 };
+    // Unchanged texels a merge may add before a separate rectangle is started.
+    inline static constexpr std::size_t s_mergeSlack{ 8 };
+
+    std::size_t m_width{};
+    std::size_t m_height{};
+    std::vector<Color> m_pixels{};
+    std::vector<DirtyRectangle> m_dirtyRectangles{};
+
+    Texture m_texture{};
+
+public:
+    DynamicTexture(std::size_t width, std::size_t height, Color color);
+
+    DynamicTexture(const DynamicTexture&) = delete;
+    DynamicTexture& operator=(const DynamicTexture&) = delete;
+
+    // Changes stay on the CPU until upload().
+    void setPixel(std::size_t x, std::size_t y, Color color);
+    void fill(Color color);
+    [[nodiscard]] Color getPixel(std::size_t x, std::size_t y) const;
+
+    // Sends the dirty rectangles and returns the number of bytes sent.
+    std::size_t upload();
+
+    [[nodiscard]] std::size_t getWidth() const noexcept;
+    [[nodiscard]] std::size_t getHeight() const noexcept;
+    [[nodiscard]] Texture& getTexture() noexcept;
+
+private:
+    void markDirty(std::size_t x, std::size_t y);
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_DYNAMIC_TEXTURE_HXX
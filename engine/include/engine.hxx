@@ -16,11 +16,17 @@
 #include <string>
 #include <string_view>
 
+#include "asset_loader.hxx"
+#include "asset_registry.hxx"
 #include "audio.hxx"
 #include "buffer.hxx"
+#include "dynamic_texture.hxx"
+#include "framebuffer.hxx"
+#include "mesh.hxx"
 #include "shader_program.hxx"
 #include "sprite.hxx"
 #include "texture.hxx"
+#include "tilemap.hxx"
 #include "view.hxx"
 
 struct Event
@@ -194,6 +200,8 @@ std::ostream& operator<<(std::ostream& out, const Event& event);
 
 std::string_view keyToStr(Event::Keyboard::Key key);
 Event::Keyboard::Key ImGuiKeyToEventKey(ImGuiKey key);
+// ImGui::Image of an engine texture, blended as premultiplied alpha like the rest of the frame.
+void ImGuiImage(const Texture& texture, const ImVec2& size);
 
 struct Triangle
 {
@@ -218,6 +226,13 @@ public:
         int height{};
     };
 
+    // GL state changes of the last frame: forwarded to GL and skipped as redundant.
+    struct RenderStatistics
+    {
+        std::size_t issuedStateCalls{};
+        std::size_t elidedStateCalls{};
+    };
+
     virtual ~IEngine() = default;
     virtual std::string initialize([[maybe_unused]] std::string_view config) = 0;
     virtual void uninitialize() = 0;
@@ -239,6 +254,24 @@ public:
                         const Texture& texture,
                         const glm::mat3& matrix,
                         const View& view) = 0;
+    // Queues the mesh to be drawn once per element of its instance buffer in a single
+    // instanced call. Like sprites it is ordered by layer and blend mode, not by submission.
+    virtual void render(const Mesh<Vertex2, std::uint16_t>& mesh,
+                        const Texture& texture,
+                        const glm::mat3& matrix,
+                        const View& view,
+                        std::uint8_t layer,
+                        BlendMode blendMode) = 0;
+    // Queues the whole tilemap as one draw; matrix maps the tile space like a mesh matrix.
+    virtual void render(const Tilemap& tilemap,
+                        const glm::mat3& matrix,
+                        const View& view,
+                        std::uint8_t layer,
+                        BlendMode blendMode) = 0;
+    // Everything submitted until endRenderTarget is drawn into the cleared framebuffer.
+    // Draws submitted for the window before are kept and drawn with the frame.
+    virtual void beginRenderTarget(Framebuffer& framebuffer) = 0;
+    virtual void endRenderTarget() = 0;
     virtual void render(const Sprite& sprite) = 0;
     virtual void render(const Sprite& sprite, const View& view) = 0;
     [[nodiscard]] virtual WindowSize getWindowSize() const noexcept = 0;
@@ -246,6 +279,7 @@ public:
     [[nodiscard]] virtual bool getVSync() const noexcept = 0;
     virtual void setFramerate(int framerate) = 0;
     [[nodiscard]] virtual int getFramerate() const noexcept = 0;
+    [[nodiscard]] virtual RenderStatistics getRenderStatistics() const noexcept = 0;
     [[nodiscard]] virtual ImGuiContext* getImGuiContext() const noexcept = 0;
     [[nodiscard]] virtual std::vector<std::string> getAudioDeviceNames() const noexcept = 0;
     [[nodiscard]] virtual const std::string& getCurrentAudioDeviceName() const noexcept = 0;
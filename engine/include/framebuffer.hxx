@@ -0,0 +1,42 @@
+#ifndef ENGINE_PREPARE_TO_GAME_FRAMEBUFFER_HXX
+#define ENGINE_PREPARE_TO_GAME_FRAMEBUFFER_HXX
+
+#include <cstddef>
+#include <cstdint>
+
+#include "texture.hxx"
+
+// Off-screen render target: a framebuffer object with an RGBA colour texture and a
+// depth buffer. Draws go to it between IEngine::beginRenderTarget and endRenderTarget,
+// after which the colour texture can be drawn like any other. Rows of the texture go
+// from bottom to top, unlike the rows of loaded images.
+class Framebuffer final
+{
+private:
+    std::uint32_t m_framebuffer{};
+    std::uint32_t m_depthBuffer{};
+    Texture m_texture{};
+    std::size_t m_width{};
+    std::size_t m_height{};
+
+public:
+    Framebuffer(std::size_t width, std::size_t height);
+    ~Framebuffer();
+
+    Framebuffer(const Framebuffer&) = delete;
+    Framebuffer& operator=(const Framebuffer&) = delete;
+
+    // Recreates the attachments, dropping their contents, when the size changes.
+    void resize(std::size_t width, std::size_t height);
+    void bind() const;
+
+    [[nodiscard]] const Texture& getTexture() const noexcept;
+    [[nodiscard]] std::size_t getWidth() const noexcept;
+    [[nodiscard]] std::size_t getHeight() const noexcept;
+
+private:
+    void create();
+    void destroy() noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_FRAMEBUFFER_HXX
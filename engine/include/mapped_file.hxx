@@ -0,0 +1,42 @@
+#ifndef ENGINE_PREPARE_TO_GAME_MAPPED_FILE_HXX
+#define ENGINE_PREPARE_TO_GAME_MAPPED_FILE_HXX
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace fs = std::filesystem;
+
+// Read-only view of a whole file mapped into memory. Pages are read on first
+// access, so opening a large file costs nothing until its data is touched.
+// Android assets live inside the APK and cannot be mapped, they are read
+// into memory through SDL instead.
+class MappedFile final
+{
+private:
+    const std::byte* m_data{};
+    std::size_t m_size{};
+
+#ifdef _WIN32
+    void* m_file{};
+    void* m_mapping{};
+#endif
+
+public:
+    explicit MappedFile(const fs::path& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& file) noexcept;
+    MappedFile& operator=(MappedFile&& file) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] std::span<const std::byte> getData() const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    void close() noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_MAPPED_FILE_HXX
@@ -0,0 +1,42 @@
+#ifndef ENGINE_PREPARE_TO_GAME_MESH_HXX
+#define ENGINE_PREPARE_TO_GAME_MESH_HXX
+
+#include <cstdint>
+
+#include "buffer.hxx"
+
+// Vertex array object pairing a vertex buffer, an index buffer and optionally an
+// instance buffer. The attribute layout is taken from VertexLayout once at
+// construction, so drawing the mesh only needs glBindVertexArray.
+// The buffers are not owned and must outlive the mesh; updating their data is fine.
+template <typename V, typename T>
+class Mesh final
+{
+private:
+    const VertexBuffer<V>& m_vertexBuffer;
+    const IndexBuffer<T>& m_indexBuffer;
+    const VertexBuffer<Instance2>* m_instanceBuffer{};
+
+    std::uint32_t m_vertexArray{};
+
+public:
+    Mesh(const VertexBuffer<V>& vertexBuffer, const IndexBuffer<T>& indexBuffer);
+    Mesh(const VertexBuffer<V>& vertexBuffer,
+         const IndexBuffer<T>& indexBuffer,
+         const VertexBuffer<Instance2>& instanceBuffer);
+    ~Mesh();
+
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
+    void bind() const;
+
+    [[nodiscard]] std::size_t getIndexCount() const noexcept;
+    [[nodiscard]] std::size_t getInstanceCount() const noexcept;
+    [[nodiscard]] bool isInstanced() const noexcept;
+
+private:
+    void create();
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_MESH_HXX
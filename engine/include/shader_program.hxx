@@ -7,16 +7,50 @@
 
 #include <glm/glm.hpp>
 
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "texture.hxx"
 
 namespace fs = std::filesystem;
 
+// Location of a uniform whose GLSL type was checked against T when it was looked up.
+// Handles stay valid until the program is recompiled.
+template <typename T>
+struct UniformHandle
+{
+    std::int32_t location{ -1 };
+};
+
 class ShaderProgram final
 {
+public:
+    // Block binding point of the per-frame camera data shared by all programs.
+    inline static constexpr std::uint32_t s_cameraBlockBinding{ 0 };
+
 private:
+    struct Uniform
+    {
+        std::int32_t location{ -1 };
+        std::uint32_t type{};
+        // Texture unit assigned at link time for samplers.
+        std::uint32_t unit{};
+    };
+
+    struct StringHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
     std::uint32_t m_program{};
+    std::unordered_map<std::string, Uniform, StringHash, std::equal_to<>> m_uniforms{};
 
     inline static std::string s_glslVersion{ "#version 330" };
 
@@ -30,12 +64,22 @@ public:
 
     void recompileShaders(const fs::path& vertPath, const fs::path& fragPath);
     void use() const;
+    template <typename T>
+    [[nodiscard]] UniformHandle<T> getUniform(std::string_view name) const;
+    [[nodiscard]] bool hasUniform(std::string_view name) const;
+    // Texture unit of a sampler, 0 if the program has no such sampler.
+    [[nodiscard]] std::uint32_t getSamplerUnit(std::string_view name) const;
+
+    void setUniform(UniformHandle<float> uniform, float value) const;
+    void setUniform(UniformHandle<glm::vec2> uniform, const glm::vec2& value) const;
+    void setUniform(UniformHandle<glm::mat3> uniform, const glm::mat3& matrix) const;
+
     void setUniform(std::string_view name, float value) const;
+    void setUniform(std::string_view name, const glm::vec2& value) const;
     void setUniform(std::string_view name, const Texture& texture) const;
     void setUniform(std::string_view name, const glm::mat3& matrix) const;
 
-        std::uint32_t
-        operator*() const noexcept;
+    std::uint32_t operator*() const noexcept;
 
     static void setGLSLVersion(const std::string& version);
 
@@ -43,6 +87,7 @@ public:
 
 private:
     static std::uint32_t compileShader(std::uint32_t type, const fs::path& path);
+    void reflectUniforms();
 };
 
 #endif // VERTEX_MORPHING_PROGRAM_HXX
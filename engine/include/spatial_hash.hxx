@@ -0,0 +1,73 @@
+#ifndef ENGINE_PREPARE_TO_GAME_SPATIAL_HASH_HXX
+#define ENGINE_PREPARE_TO_GAME_SPATIAL_HASH_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "structures.hxx"
+
+// Broadphase for moving objects: a uniform grid of square cells hashed by their
+// coordinates, each listing the objects whose bounds overlap it. Objects are
+// addressed by handles that stay valid until removed; a removed handle may be
+// handed out again. Queries and pairs are checked against the exact bounds, so
+// callers only see real overlaps. Cells should be about the size of the objects.
+class SpatialHash final
+{
+public:
+    using Handle = std::uint32_t;
+
+private:
+    struct Object
+    {
+        Rectangle bounds{};
+        std::uint64_t userData{};
+        // Cells covered by the bounds, inclusive.
+        std::int32_t firstColumn{};
+        std::int32_t firstRow{};
+        std::int32_t lastColumn{};
+        std::int32_t lastRow{};
+        bool isAlive{};
+        // Last query that reported the object, to report it once.
+        mutable std::uint32_t queryStamp{};
+    };
+
+    float m_cellSize{};
+    std::vector<Object> m_objects{};
+    std::vector<Handle> m_freeHandles{};
+    std::unordered_map<std::uint64_t, std::vector<Handle>> m_cells{};
+    std::size_t m_size{};
+    mutable std::uint32_t m_queryStamp{};
+
+public:
+    explicit SpatialHash(float cellSize);
+
+    // User data is not interpreted, it usually maps the handle back to its owner.
+    [[nodiscard]] Handle insert(const Rectangle& bounds, std::uint64_t userData = 0);
+    void move(Handle handle, const Rectangle& bounds);
+    void remove(Handle handle);
+    void clear();
+
+    void setUserData(Handle handle, std::uint64_t userData);
+    [[nodiscard]] std::uint64_t getUserData(Handle handle) const;
+    [[nodiscard]] const Rectangle& getBounds(Handle handle) const;
+
+    // Appends the objects overlapping the area.
+    void query(const Rectangle& area, std::vector<Handle>& result) const;
+    // Appends every pair of overlapping objects once, the lower handle first.
+    void findPairs(std::vector<std::pair<Handle, Handle>>& pairs) const;
+
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    [[nodiscard]] Object& getObject(Handle handle);
+    [[nodiscard]] const Object& getObject(Handle handle) const;
+    void setCells(Object& object, const Rectangle& bounds) const noexcept;
+    void link(Handle handle);
+    void unlink(Handle handle);
+    [[nodiscard]] static std::uint64_t getCellKey(std::int32_t column, std::int32_t row) noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_SPATIAL_HASH_HXX
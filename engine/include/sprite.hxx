@@ -2,13 +2,23 @@
 #define VERTEX_MORPHING_SPRITE_HXX
 #include <glm/glm.hpp>
 
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <optional>
-#include <vector>
 
 #include "buffer.hxx"
 #include "structures.hxx"
 #include "texture.hxx"
 
+// How a draw is combined with what is already on screen. Opaque draws write depth
+// and are sorted front-to-back, blended ones are sorted back-to-front on top of them.
+enum class BlendMode
+{
+    opaque,
+    alpha
+};
+
 class Sprite final
 {
 private:
@@ -17,8 +27,12 @@ private:
     Scale m_scale{};
     Angle m_rotationAngle{};
 
-    bool m_hasTexture{};
-    Texture* m_texture{};
+    // Set when the sprite was made from a path, shared through AssetRegistry.
+    std::shared_ptr<const Texture> m_ownTexture{};
+    const Texture* m_texture{};
+
+    std::uint8_t m_layer{};
+    BlendMode m_blendMode{ BlendMode::alpha };
 
     glm::mat3 m_moveMatrix{ 0.0f };
     glm::mat3 m_scaleMatrix{ 0.0f };
@@ -30,14 +44,10 @@ private:
 
     inline static Size s_originalWindowSize{};
 
-    std::vector<Vertex2> m_vertices{};
-    std::vector<uint16_t> m_indices{};
-
 public:
     explicit Sprite(Size size);
     explicit Sprite(const fs::path& texturePath);
     Sprite(const fs::path& texturePath, Size size);
-    ~Sprite();
 
     Sprite(const Sprite&) = delete;
     Sprite& operator=(const Sprite&) = delete;
@@ -59,14 +69,27 @@ public:
     void updateWindowSize();
     void setTexture(Texture& texture);
 
-    [[nodiscard]] const std::vector<Vertex2>& getVertices() const noexcept;
-    [[nodiscard]] const std::vector<uint16_t>& getIndices() const noexcept;
     [[nodiscard]] const Texture& getTexture() const noexcept;
+
+    // Higher layers are drawn in front of lower ones regardless of submission order.
+    void setLayer(std::uint8_t layer) noexcept;
+    [[nodiscard]] std::uint8_t getLayer() const noexcept;
+
+    void setBlendMode(BlendMode blendMode) noexcept;
+    [[nodiscard]] BlendMode getBlendMode() const noexcept;
+
+    // Maps the unit quad to the sprite on screen, the sprite size included.
     [[nodiscard]] glm::mat3 getResultMatrix() const noexcept;
+    // Same transform without the sprite size, for geometry already built in screen space.
+    [[nodiscard]] glm::mat3 getTransformMatrix() const noexcept;
     [[nodiscard]] Rectangle getRectangle() const noexcept;
 
     static void setOriginalSize(Size size);
 
+    // Every sprite shares this quad centered at origin with side 1.
+    static const std::array<Vertex2, 4>& getUnitQuadVertices() noexcept;
+    static const std::array<std::uint16_t, 6>& getUnitQuadIndices() noexcept;
+
 private:
     void initialize();
 };
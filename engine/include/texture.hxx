@@ -1,14 +1,18 @@
 #ifndef VERTEX_MORPHING_TEXTURE_HXX
 #define VERTEX_MORPHING_TEXTURE_HXX
 
+#include <cstdint>
+#include <cstddef>
 #include <filesystem>
+#include <span>
+#include <vector>
+
+#include "structures.hxx"
 
 using namespace std::literals;
 namespace fs = std::filesystem;
 
 #ifdef __ANDROID__
-#    include <vector>
-
 class Image
 {
 private:
@@ -25,6 +29,7 @@ public:
     ~Image();
 
     void load(const fs::path& path);
+    void load(std::span<const std::byte> file);
     [[nodiscard]] const unsigned char* getPixels() const noexcept;
     [[nodiscard]] int getWidth() const noexcept;
     [[nodiscard]] int getHeight() const noexcept;
@@ -34,36 +39,67 @@ private:
 };
 #endif
 
+// Decoded RGBA8 pixels with premultiplied alpha, rows from top to bottom.
+struct PixelData
+{
+    std::vector<std::uint8_t> pixels{};
+    std::size_t width{};
+    std::size_t height{};
+};
+
+// The file an image is read from: its cooked file if that is up to date, see
+// cooked_texture.hxx, and the image itself otherwise.
+fs::path findImageFile(const fs::path& path);
+
+// Reads the cooked file of the image if it is up to date and decodes the PNG otherwise.
+PixelData decodeImage(const fs::path& path);
+// Decodes a cooked texture or a PNG held in memory.
+PixelData decodeImage(std::span<const std::byte> file);
+
+// A texture owns the GL texture it loads and deletes it when destroyed or
+// reloaded. Copies and regions are views that never delete it, so the texture
+// they were made from must outlive them; AssetRegistry shares owners instead.
 class Texture final
 {
 private:
     std::uint32_t m_texture{};
     std::size_t m_width{};
     std::size_t m_height{};
-#ifdef __ANDROID__
-    Image m_image{};
-#endif
+    // Normalized sub-rectangle of the GL texture this object refers to.
+    Rectangle m_region{ .xy = { 0.0f, 0.0f }, .wh = { 1.0f, 1.0f } };
 
-    bool m_copied{};
+    bool m_isOwner{};
 
 public:
     Texture() = default;
-    Texture(Texture& texture);
-    Texture& operator=(Texture& texture);
+    Texture(const Texture& texture);
+    // View of a region of texture given in pixels, e.g. an atlas entry.
+    Texture(const Texture& texture, const Rectangle& region);
+    Texture& operator=(const Texture& texture);
 
     Texture(Texture&& texture) = delete;
     Texture& operator=(Texture&& texture) = delete;
 
     ~Texture();
 
+    // Maps the cooked file of the image when it is up to date and decodes the PNG otherwise.
     void load(const fs::path& path);
+    // Loads a cooked texture or a PNG held in memory, e.g. an AssetPack entry.
+    void load(std::span<const std::byte> file);
+    // Pixels are RGBA8 with premultiplied alpha, rows from top to bottom.
     void load(const void* pixels, std::size_t width, std::size_t height);
     void bind() const;
 
     [[nodiscard]] std::size_t getWidth() const noexcept;
     [[nodiscard]] std::size_t getHeight() const noexcept;
+    [[nodiscard]] const Rectangle& getRegion() const noexcept;
+    [[nodiscard]] bool hasRegion() const noexcept;
 
     std::uint32_t operator*() const noexcept;
+
+private:
+    void loadCooked(std::span<const std::byte> file);
+    void release() noexcept;
 };
 
 #endif // VERTEX_MORPHING_TEXTURE_HXX
@@ -0,0 +1,73 @@
+#ifndef ENGINE_PREPARE_TO_GAME_TILEMAP_HXX
+#define ENGINE_PREPARE_TO_GAME_TILEMAP_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "tileset.hxx"
+
+namespace fs = std::filesystem;
+
+// Grid of tile ids drawn in a single pass: the ids live in an R8 texture, one byte
+// per tile, and the fragment shader of a quad over the grid looks them up and
+// samples the tile image from a texture array. Id 0 is an empty cell, id i shows
+// image i - 1 of the tileset. Tile (column, row) covers [column, column + 1] x
+// [row, row + 1] of the tile space, row 0 at the bottom.
+class Tilemap final
+{
+public:
+    inline static constexpr std::uint8_t s_empty{ 0 };
+
+private:
+    std::size_t m_columns{};
+    std::size_t m_rows{};
+    std::vector<std::uint8_t> m_tiles{};
+
+    std::uint32_t m_tileTexture{};
+    std::shared_ptr<const Tileset> m_tileset{};
+
+    // Bounds of the tiles changed since the last upload, as half-open ranges.
+    std::size_t m_dirtyFirstColumn{};
+    std::size_t m_dirtyLastColumn{};
+    std::size_t m_dirtyFirstRow{};
+    std::size_t m_dirtyLastRow{};
+
+public:
+    // Loads a tileset of its own, see Tileset for the image requirements.
+    Tilemap(std::size_t columns, std::size_t rows, const std::vector<fs::path>& tileset);
+    Tilemap(std::size_t columns, std::size_t rows, std::shared_ptr<const Tileset> tileset);
+    ~Tilemap();
+
+    Tilemap(const Tilemap&) = delete;
+    Tilemap& operator=(const Tilemap&) = delete;
+
+    // Changes stay on the CPU until upload().
+    void setTile(std::size_t column, std::size_t row, std::uint8_t id);
+    void fill(std::uint8_t id);
+    // Replaces the whole grid with ids laid out row by row from the bottom.
+    void setTiles(std::span<const std::uint8_t> tiles);
+    [[nodiscard]] std::uint8_t getTile(std::size_t column, std::size_t row) const;
+
+    // Sends the rectangle of tiles touched since the last call with one glTexSubImage2D.
+    void upload();
+    void bind(std::uint32_t tileUnit, std::uint32_t tilesetUnit) const;
+
+    [[nodiscard]] std::size_t getColumns() const noexcept;
+    [[nodiscard]] std::size_t getRows() const noexcept;
+    [[nodiscard]] std::size_t getTilesetSize() const noexcept;
+
+    // GL name of the tile id texture.
+    std::uint32_t operator*() const noexcept;
+
+private:
+    void markDirty(std::size_t firstColumn,
+                   std::size_t lastColumn,
+                   std::size_t firstRow,
+                   std::size_t lastRow) noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_TILEMAP_HXX
@@ -0,0 +1,36 @@
+#ifndef ENGINE_PREPARE_TO_GAME_TILESET_HXX
+#define ENGINE_PREPARE_TO_GAME_TILESET_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Tile images in one texture array, shared by all tilemaps that draw them so
+// that the images are decoded and uploaded once.
+class Tileset final
+{
+private:
+    std::uint32_t m_texture{};
+    std::size_t m_size{};
+
+public:
+    // All tile images must have the same size; at most 255 of them fit the tile ids.
+    // Images are read through AssetRegistry, so mounted packs provide them first.
+    explicit Tileset(const std::vector<fs::path>& images);
+    ~Tileset();
+
+    Tileset(const Tileset&) = delete;
+    Tileset& operator=(const Tileset&) = delete;
+
+    void bind(std::uint32_t unit) const;
+
+    [[nodiscard]] std::size_t getSize() const noexcept;
+
+    // GL name of the texture array.
+    std::uint32_t operator*() const noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_TILESET_HXX
@@ -19,6 +19,9 @@ public:
 
     void setScale(float scale);
     [[nodiscard]] float getScale() const noexcept;
+
+    // Area of the world seen through the view, in the units of getPosition.
+    [[nodiscard]] Rectangle getVisibleRectangle() const;
 };
 
 #endif // ENGINE_PREPARE_TO_GAME_VIEW_HXX
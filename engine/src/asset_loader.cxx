@@ -0,0 +1,219 @@
+#include "asset_loader.hxx"
+
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+#include "asset_registry.hxx"
+#include "file_reader.hxx"
+
+using namespace std::literals;
+
+AssetLoader::TextureHandle::TextureHandle(std::shared_ptr<TextureState> state)
+    : m_state{ std::move(state) } {}
+
+Texture& AssetLoader::TextureHandle::getTexture() const {
+    if (!m_state) throw std::runtime_error{ "Error : TextureHandle::getTexture : empty handle"s };
+
+    return m_state->texture;
+}
+
+AssetLoader::Status AssetLoader::TextureHandle::getStatus() const {
+    if (!m_state) throw std::runtime_error{ "Error : TextureHandle::getStatus : empty handle"s };
+
+    return m_state->status.load(std::memory_order_acquire);
+}
+
+bool AssetLoader::TextureHandle::isReady() const { return getStatus() == Status::ready; }
+
+const std::string& AssetLoader::TextureHandle::getError() const {
+    if (getStatus() != Status::failed)
+        throw std::runtime_error{ "Error : TextureHandle::getError : texture has not failed"s };
+
+    return m_state->error;
+}
+
+AssetLoader::AudioHandle::AudioHandle(std::shared_ptr<AudioState> state)
+    : m_state{ std::move(state) } {}
+
+void AssetLoader::AudioHandle::play(bool isLooped) {
+    if (!m_state) throw std::runtime_error{ "Error : AudioHandle::play : empty handle"s };
+
+    std::lock_guard lock{ m_state->mutex };
+    if (m_state->audio)
+        m_state->audio->play(isLooped);
+    else
+        m_state->pendingPlay = isLooped;
+}
+
+AssetLoader::Status AssetLoader::AudioHandle::getStatus() const {
+    if (!m_state) throw std::runtime_error{ "Error : AudioHandle::getStatus : empty handle"s };
+
+    return m_state->status.load(std::memory_order_acquire);
+}
+
+bool AssetLoader::AudioHandle::isReady() const { return getStatus() == Status::ready; }
+
+const std::string& AssetLoader::AudioHandle::getError() const {
+    if (getStatus() != Status::failed)
+        throw std::runtime_error{ "Error : AudioHandle::getError : audio has not failed"s };
+
+    return m_state->error;
+}
+
+AssetLoader::AssetLoader(std::size_t threadCount, std::chrono::microseconds uploadBudget)
+    : m_uploadBudget{ uploadBudget } {
+    if (threadCount == 0)
+        throw std::runtime_error{ "Error : AssetLoader::AssetLoader : no worker threads"s };
+
+    static constexpr std::array<std::uint8_t, 4> transparent{};
+    m_placeholder.load(transparent.data(), 1, 1);
+
+    // Made first, so a throw here leaves no worker threads to join.
+    m_reader = std::make_unique<FileReader>(threadCount);
+
+    for (std::size_t i{}; i < threadCount; ++i)
+        m_workers.emplace_back(&AssetLoader::run, this);
+}
+
+AssetLoader::~AssetLoader() {
+    // Reads still running hand their files to the workers, so they finish first.
+    m_reader.reset();
+
+    {
+        std::lock_guard lock{ m_mutex };
+        m_isStopping = true;
+    }
+
+    m_condition.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+AssetLoader::TextureHandle AssetLoader::loadTexture(const fs::path& path) {
+    auto state{ std::make_shared<TextureState>() };
+    // Shares the GL name of the placeholder until the upload gives it its own.
+    state->texture = m_placeholder;
+
+    auto decode{ [this, state, path](std::span<const std::byte> data, std::exception_ptr error) {
+        try {
+            if (error) std::rethrow_exception(error);
+            auto pixels{ decodeImage(data) };
+
+            std::lock_guard lock{ m_mutex };
+            m_decoded.emplace_back(state, std::move(pixels));
+        }
+        catch (const std::exception& e) {
+            std::cerr << "texture failed to load: "sv << path << ": "sv << e.what() << '\n';
+            state->error = e.what();
+            state->status.store(Status::failed, std::memory_order_release);
+            --m_pendingCount;
+        }
+    } };
+
+    if (auto file{ AssetRegistry::getInstance().findImageInPacks(path) })
+        addPacked(*file, std::move(decode));
+    else
+        addRead(findImageFile(path), std::move(decode));
+    return TextureHandle{ std::move(state) };
+}
+
+AssetLoader::AudioHandle AssetLoader::loadAudio(const fs::path& path) {
+    auto state{ std::make_shared<AudioState>() };
+
+    // Sounds need no GL, so they are finished on the worker.
+    auto decode{ [this, state, path](std::span<const std::byte> data, std::exception_ptr error) {
+        try {
+            if (error) std::rethrow_exception(error);
+            auto audio{ std::make_unique<Audio>(data) };
+
+            std::lock_guard lock{ state->mutex };
+            if (state->pendingPlay) audio->play(*state->pendingPlay);
+            state->audio = std::move(audio);
+            state->status.store(Status::ready, std::memory_order_release);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "audio failed to load: "sv << path << ": "sv << e.what() << '\n';
+            state->error = e.what();
+            state->status.store(Status::failed, std::memory_order_release);
+        }
+
+        --m_pendingCount;
+    } };
+
+    if (auto file{ AssetRegistry::getInstance().findInPacks(path) })
+        addPacked(*file, std::move(decode));
+    else
+        addRead(path, std::move(decode));
+    return AudioHandle{ std::move(state) };
+}
+
+void AssetLoader::submit() { m_reader->submit(); }
+
+std::size_t AssetLoader::update() {
+    submit();
+
+    auto start{ std::chrono::steady_clock::now() };
+    std::size_t uploadCount{};
+
+    while (uploadCount == 0 || std::chrono::steady_clock::now() - start < m_uploadBudget) {
+        std::unique_lock lock{ m_mutex };
+        if (m_decoded.empty()) break;
+
+        auto [state, data]{ std::move(m_decoded.front()) };
+        m_decoded.pop_front();
+        lock.unlock();
+
+        state->texture.load(data.pixels.data(), data.width, data.height);
+        state->status.store(Status::ready, std::memory_order_release);
+        --m_pendingCount;
+        ++uploadCount;
+    }
+
+    return uploadCount;
+}
+
+bool AssetLoader::isIdle() const noexcept { return m_pendingCount == 0; }
+
+void AssetLoader::addRead(const fs::path& path, ReadJob job) {
+    ++m_pendingCount;
+
+    // Decoding goes to the workers, so the reader is free for the next file at once.
+    m_reader->read(path, [this, job](std::vector<std::byte>&& data, std::exception_ptr error) {
+        addJob([job, data = std::move(data), error] { job(data, error); });
+    });
+}
+
+void AssetLoader::addPacked(std::span<const std::byte> file, ReadJob job) {
+    ++m_pendingCount;
+
+    // The pack is already in memory, so there is nothing to read.
+    addJob([job = std::move(job), file] { job(file, nullptr); });
+}
+
+void AssetLoader::addJob(std::function<void()> job) {
+    {
+        std::lock_guard lock{ m_mutex };
+        m_jobs.push_back(std::move(job));
+    }
+
+    m_condition.notify_one();
+}
+
+void AssetLoader::run() {
+    std::unique_lock lock{ m_mutex };
+
+    while (true) {
+        m_condition.wait(lock, [this] { return m_isStopping || !m_jobs.empty(); });
+        if (m_isStopping) return;
+
+        auto job{ std::move(m_jobs.front()) };
+        m_jobs.pop_front();
+
+        lock.unlock();
+        job();
+        lock.lock();
+    }
+}
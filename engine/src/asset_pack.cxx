@@ -0,0 +1,70 @@
+#include "asset_pack.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals;
+
+AssetPack::AssetPack(const fs::path& path) : m_file{ path } {
+    auto file{ m_file.getData() };
+
+    auto fail{ [&path](std::string_view message) {
+        throw std::runtime_error{ "Error : AssetPack::AssetPack : "s + std::string{ message } +
+                                  ": "s + path.string() };
+    } };
+
+    AssetPackHeader header{};
+    if (file.size() < sizeof(header)) fail("file is too small"sv);
+
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (header.magic != asset_pack_magic || header.version != asset_pack_version)
+        fail("not an asset pack"sv);
+
+    auto entriesEnd{ sizeof(header) + std::size_t{ header.entryCount } * sizeof(AssetPackEntry) };
+    if (entriesEnd > file.size() || header.namesOffset < entriesEnd ||
+        header.namesOffset > file.size() || header.namesSize > file.size() - header.namesOffset)
+        fail("table of contents is truncated"sv);
+
+    std::string_view names{ reinterpret_cast<const char*>(file.data()) + header.namesOffset,
+                            header.namesSize };
+
+    m_entries.reserve(header.entryCount);
+    for (std::size_t i{}; i < header.entryCount; ++i) {
+        AssetPackEntry entry{};
+        std::memcpy(&entry, file.data() + sizeof(header) + i * sizeof(entry), sizeof(entry));
+
+        if (entry.nameOffset > names.size() || entry.nameSize > names.size() - entry.nameOffset ||
+            entry.offset > file.size() || entry.size > file.size() - entry.offset)
+            fail("entry is out of the pack"sv);
+
+        m_entries.push_back({ .name = names.substr(entry.nameOffset, entry.nameSize),
+                              .data = file.subspan(entry.offset, entry.size) });
+    }
+
+    // Lookups rely on the order the packer wrote.
+    if (std::ranges::adjacent_find(m_entries, std::ranges::greater_equal{}, &Entry::name) !=
+        m_entries.end())
+        fail("names are not sorted"sv);
+}
+
+std::optional<std::span<const std::byte>> AssetPack::find(std::string_view name) const noexcept {
+    auto found{ std::ranges::lower_bound(m_entries, name, {}, &Entry::name) };
+    if (found == m_entries.end() || found->name != name) return std::nullopt;
+
+    return found->data;
+}
+
+std::span<const std::byte> AssetPack::get(std::string_view name) const {
+    auto data{ find(name) };
+    if (!data)
+        throw std::runtime_error{ "Error : AssetPack::get : no file "s + std::string{ name } };
+
+    return *data;
+}
+
+bool AssetPack::contains(std::string_view name) const noexcept { return find(name).has_value(); }
+
+std::size_t AssetPack::size() const noexcept { return m_entries.size(); }
@@ -0,0 +1,95 @@
+#include "asset_registry.hxx"
+
+#include <ranges>
+#include <utility>
+
+#include "cooked_texture.hxx"
+
+AssetRegistry& AssetRegistry::getInstance() {
+    static AssetRegistry assetRegistry{};
+
+    return assetRegistry;
+}
+
+void AssetRegistry::mount(const fs::path& packPath) { m_packs.emplace_back(packPath); }
+
+std::shared_ptr<const Texture> AssetRegistry::getTexture(const fs::path& path) {
+    auto key{ normalize(path) };
+
+    if (auto found{ m_textures.find(key) }; found != m_textures.end()) return found->second;
+
+    // The entry is added only once the file loaded, a failed load is not cached.
+    auto texture{ std::make_shared<Texture>() };
+
+    if (auto file{ findImageInPacks(key) })
+        texture->load(*file);
+    else
+        texture->load(key);
+
+    return m_textures.try_emplace(std::move(key), std::move(texture)).first->second;
+}
+
+std::shared_ptr<Audio> AssetRegistry::getAudio(const fs::path& path) {
+    auto key{ normalize(path) };
+
+    if (auto found{ m_sounds.find(key) }; found != m_sounds.end()) return found->second;
+
+    auto file{ findPacked(key) };
+    auto audio{ file ? std::make_shared<Audio>(*file) : std::make_shared<Audio>(key) };
+
+    return m_sounds.try_emplace(std::move(key), std::move(audio)).first->second;
+}
+
+bool AssetRegistry::evict(const fs::path& path) {
+    auto key{ normalize(path) };
+
+    auto erased{ m_textures.erase(key) };
+    erased += m_sounds.erase(key);
+    return erased != 0;
+}
+
+std::size_t AssetRegistry::evictUnused() {
+    auto isUnused{ [](const auto& entry) { return entry.second.use_count() == 1; } };
+
+    return std::erase_if(m_textures, isUnused) + std::erase_if(m_sounds, isUnused);
+}
+
+void AssetRegistry::clear() {
+    m_textures.clear();
+    m_sounds.clear();
+    m_packs.clear();
+}
+
+std::size_t AssetRegistry::getTextureCount() const noexcept { return m_textures.size(); }
+
+std::size_t AssetRegistry::getAudioCount() const noexcept { return m_sounds.size(); }
+
+std::optional<std::span<const std::byte>>
+AssetRegistry::findInPacks(const fs::path& path) const {
+    return findPacked(normalize(path));
+}
+
+std::optional<std::span<const std::byte>>
+AssetRegistry::findImageInPacks(const fs::path& path) const {
+    auto key{ normalize(path) };
+    auto cookedKey{ fs::path{ key }.replace_extension(cooked_texture_extension).generic_string() };
+
+    if (auto cooked{ findPacked(cookedKey) }) return cooked;
+    return findPacked(key);
+}
+
+PixelData AssetRegistry::readImage(const fs::path& path) const {
+    if (auto file{ findImageInPacks(path) }) return decodeImage(*file);
+    return decodeImage(path);
+}
+
+std::optional<std::span<const std::byte>> AssetRegistry::findPacked(std::string_view name) const {
+    for (const auto& pack : m_packs | std::views::reverse)
+        if (auto file{ pack.find(name) }) return file;
+
+    return std::nullopt;
+}
+
+std::string AssetRegistry::normalize(const fs::path& path) {
+    return path.lexically_normal().generic_string();
+}
@@ -0,0 +1,188 @@
+#include "atlas.hxx"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+#include "asset_registry.hxx"
+
+using namespace std::literals;
+
+Texture& Atlas::getTexture(std::string_view name) {
+    auto found{ m_textures.find(std::string{ name }) };
+    if (found == m_textures.end())
+        throw std::runtime_error{ "Error : Atlas::getTexture : no texture "s +
+                                  std::string{ name } };
+
+    return *found->second;
+}
+
+bool Atlas::contains(std::string_view name) const {
+    return m_textures.contains(std::string{ name });
+}
+
+std::size_t Atlas::getPageCount() const noexcept { return m_pages.size(); }
+
+AtlasBuilder::AtlasBuilder(std::size_t pageWidth, std::size_t pageHeight, std::size_t padding)
+    : m_pageWidth{ pageWidth }, m_pageHeight{ pageHeight }, m_padding{ padding } {}
+
+void AtlasBuilder::add(std::string name, const fs::path& path) {
+    add(std::move(name), AssetRegistry::getInstance().readImage(path));
+}
+
+void AtlasBuilder::add(std::string name, PixelData data) {
+    if (data.width == 0 || data.height == 0)
+        throw std::runtime_error{ "Error : AtlasBuilder::add : empty image "s + name };
+
+    if (data.width + 2 * m_padding > m_pageWidth || data.height + 2 * m_padding > m_pageHeight)
+        throw std::runtime_error{ "Error : AtlasBuilder::add : image is larger than page "s +
+                                  name };
+
+    m_images.push_back({ .name = std::move(name), .data = std::move(data) });
+}
+
+Atlas AtlasBuilder::build() {
+    // Tall images first keep the skyline flat, the name makes the order reproducible.
+    std::vector<std::size_t> order(m_images.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [this](std::size_t lhs, std::size_t rhs) {
+        const auto& l{ m_images[lhs] };
+        const auto& r{ m_images[rhs] };
+        return std::tuple{ r.data.height, r.data.width, l.name } <
+               std::tuple{ l.data.height, l.data.width, r.name };
+    });
+
+    std::vector<Page> pages{};
+    std::vector<std::pair<std::size_t, Rectangle>> regions(m_images.size());
+
+    for (auto index : order) {
+        const auto& image{ m_images[index] };
+        auto width{ image.data.width + 2 * m_padding };
+        auto height{ image.data.height + 2 * m_padding };
+
+        std::optional<Placement> placement{};
+        std::size_t pageIndex{};
+        for (; pageIndex < pages.size(); ++pageIndex)
+            if ((placement = findPlacement(pages[pageIndex], width, height))) break;
+
+        if (!placement) {
+            pages.push_back(createPage());
+            placement = findPlacement(pages.back(), width, height);
+        }
+
+        auto& page{ pages.at(pageIndex) };
+        addSkylineLevel(page, *placement, width, height);
+        copyPixels(page, image, placement->x, placement->y);
+
+        regions[index] = {
+            pageIndex,
+            Rectangle{ .xy = { static_cast<float>(placement->x + m_padding),
+                               static_cast<float>(placement->y + m_padding) },
+                       .wh = { static_cast<float>(image.data.width),
+                               static_cast<float>(image.data.height) } }
+        };
+    }
+
+    Atlas atlas{};
+    for (const auto& page : pages) {
+        atlas.m_pages.push_back(std::make_unique<Texture>());
+        atlas.m_pages.back()->load(page.pixels.data(), m_pageWidth, m_pageHeight);
+    }
+
+    for (std::size_t i{}; i < m_images.size(); ++i) {
+        const auto& [pageIndex, region]{ regions[i] };
+        atlas.m_textures[m_images[i].name] =
+            std::make_unique<Texture>(*atlas.m_pages.at(pageIndex), region);
+    }
+
+    m_images.clear();
+    return atlas;
+}
+
+AtlasBuilder::Page AtlasBuilder::createPage() const {
+    Page page{};
+    page.skyline.push_back({ .x = 0, .y = 0, .width = m_pageWidth });
+    page.pixels.resize(m_pageWidth * m_pageHeight * 4);
+    return page;
+}
+
+std::optional<AtlasBuilder::Placement>
+AtlasBuilder::findPlacement(const Page& page, std::size_t width, std::size_t height) const {
+    std::optional<Placement> best{};
+
+    for (std::size_t node{}; node < page.skyline.size(); ++node) {
+        auto x{ page.skyline[node].x };
+        if (x + width > m_pageWidth) break;
+
+        // The rectangle rests on the highest node it spans.
+        std::size_t y{};
+        for (std::size_t spanned{ node }, covered{};
+             covered < width && spanned < page.skyline.size();
+             ++spanned) {
+            y = std::max(y, page.skyline[spanned].y);
+            covered += page.skyline[spanned].width;
+        }
+
+        if (y + height > m_pageHeight) continue;
+        if (!best || y < best->y || (y == best->y && x < best->x))
+            best = Placement{ .x = x, .y = y, .node = node };
+    }
+
+    return best;
+}
+
+void AtlasBuilder::addSkylineLevel(Page& page,
+                                   const Placement& placement,
+                                   std::size_t width,
+                                   std::size_t height) {
+    auto& skyline{ page.skyline };
+    skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(placement.node),
+                   { .x = placement.x, .y = placement.y + height, .width = width });
+
+    // Cut the nodes now hidden below the new level.
+    auto right{ placement.x + width };
+    for (auto node{ placement.node + 1 }; node < skyline.size();) {
+        auto& current{ skyline[node] };
+        if (current.x >= right) break;
+
+        auto overlap{ right - current.x };
+        if (overlap >= current.width) {
+            skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(node));
+            continue;
+        }
+
+        current.x += overlap;
+        current.width -= overlap;
+        break;
+    }
+
+    for (std::size_t node{}; node + 1 < skyline.size();) {
+        if (skyline[node].y == skyline[node + 1].y) {
+            skyline[node].width += skyline[node + 1].width;
+            skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(node) + 1);
+        }
+        else
+            ++node;
+    }
+}
+
+void AtlasBuilder::copyPixels(Page& page, const Image& image, std::size_t x, std::size_t y) const {
+    const auto& data{ image.data };
+
+    // Padding repeats the nearest edge pixel of the image.
+    for (std::size_t row{}; row < data.height + 2 * m_padding; ++row) {
+        auto sourceRow{ std::clamp(row, m_padding, m_padding + data.height - 1) - m_padding };
+
+        for (std::size_t column{}; column < data.width + 2 * m_padding; ++column) {
+            auto sourceColumn{ std::clamp(column, m_padding, m_padding + data.width - 1) -
+                               m_padding };
+
+            auto source{ (sourceRow * data.width + sourceColumn) * 4 };
+            auto destination{ ((y + row) * m_pageWidth + x + column) * 4 };
+            std::copy_n(data.pixels.begin() + static_cast<std::ptrdiff_t>(source),
+                        4,
+                        page.pixels.begin() + static_cast<std::ptrdiff_t>(destination));
+        }
+    }
+}
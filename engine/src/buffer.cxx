@@ -4,10 +4,17 @@
 
 #include "buffer.hxx"
 
+#include <algorithm>
+#include <cstddef>
 #include <fstream>
 #include <glad/glad.h>
+#include <stdexcept>
+#include <string>
 
 #include "opengl_check.hxx"
+#include "render_state.hxx"
+
+using namespace std::literals;
 
 std::ifstream& operator>>(std::ifstream& in, Vertex& vertex) {
     in >> vertex.x >> vertex.y >> vertex.z >> vertex.texX >> vertex.texY;
@@ -21,70 +28,149 @@ std::ifstream& operator>>(std::ifstream& in, Vertex2& vertex) {
     return in;
 }
 
+static GLenum toGLUsage(BufferUsage usage) {
+    switch (usage) {
+    case BufferUsage::dynamic_draw:
+        return GL_DYNAMIC_DRAW;
+    case BufferUsage::stream_draw:
+        return GL_STREAM_DRAW;
+    case BufferUsage::static_draw:
+    default:
+        return GL_STATIC_DRAW;
+    }
+}
+
+// Uploads count elements starting at first to the buffer bound to target.
+// Storage that is too small grows geometrically and receives the whole contents.
+static void uploadRange(GLenum target,
+                        BufferUsage usage,
+                        std::size_t& capacity,
+                        const void* data,
+                        std::size_t elementSize,
+                        std::size_t size,
+                        std::size_t first,
+                        std::size_t count) {
+    if (size > capacity) {
+        capacity = std::max(size, capacity * 2);
+        glBufferData(target,
+                     static_cast<GLsizeiptr>(capacity * elementSize),
+                     nullptr,
+                     toGLUsage(usage));
+        openGLCheck();
+
+        first = 0;
+        count = size;
+    }
+    else if (usage == BufferUsage::stream_draw && first == 0 && count == size) {
+        // Orphaning gives a fresh storage instead of waiting for the previous frame.
+        glBufferData(target,
+                     static_cast<GLsizeiptr>(capacity * elementSize),
+                     nullptr,
+                     toGLUsage(usage));
+        openGLCheck();
+    }
+
+    if (count == 0) return;
+
+    glBufferSubData(target,
+                    static_cast<GLintptr>(first * elementSize),
+                    static_cast<GLsizeiptr>(count * elementSize),
+                    static_cast<const std::byte*>(data) + first * elementSize);
+    openGLCheck();
+}
+
 template <typename V>
-VertexBuffer<V>::VertexBuffer(std::vector<V>&& vertices) : m_vertices{ std::move(vertices) } {
+VertexBuffer<V>::VertexBuffer(std::vector<V>&& vertices, BufferUsage usage)
+    : m_vertices{ std::move(vertices) }, m_usage{ usage } {
     glGenBuffers(1, &m_vertexBuffer);
     openGLCheck();
 
-    updateData();
+    upload(0, m_vertices.size());
 }
 
 template <typename V>
-VertexBuffer<V>::VertexBuffer(const std::vector<V>& vertices) : m_vertices{ vertices } {
+VertexBuffer<V>::VertexBuffer(const std::vector<V>& vertices, BufferUsage usage)
+    : m_vertices{ vertices }, m_usage{ usage } {
     glGenBuffers(1, &m_vertexBuffer);
     openGLCheck();
 
-    updateData();
+    upload(0, m_vertices.size());
 }
 
 template <typename V>
 void VertexBuffer<V>::updateData(std::vector<V>&& vertices) {
     m_vertices = std::move(vertices);
-    updateData();
+    upload(0, m_vertices.size());
 }
 
 template <typename V>
 void VertexBuffer<V>::updateData(const std::vector<V>& vertices) {
     m_vertices = vertices;
-    updateData();
+    upload(0, m_vertices.size());
 }
 
 template <typename V>
-void VertexBuffer<V>::updateData() const {
-    bind();
+void VertexBuffer<V>::updateData(std::size_t first, std::span<const V> vertices) {
+    if (first > m_vertices.size())
+        throw std::runtime_error{ "Error : VertexBuffer::updateData : first is past the end"s };
 
-    glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(V), m_vertices.data(), GL_STATIC_DRAW);
-    openGLCheck();
+    if (first + vertices.size() > m_vertices.size()) m_vertices.resize(first + vertices.size());
+    std::ranges::copy(vertices, m_vertices.begin() + static_cast<std::ptrdiff_t>(first));
+
+    upload(first, vertices.size());
 }
 
 template <typename V>
 void VertexBuffer<V>::addData(std::vector<V>&& vertices) {
+    auto first{ m_vertices.size() };
     m_vertices.insert(m_vertices.end(),
                       std::make_move_iterator(vertices.begin()),
                       std::make_move_iterator(vertices.end()));
 
-    updateData();
+    upload(first, m_vertices.size() - first);
 }
 
 template <typename V>
 void VertexBuffer<V>::addData(const std::vector<V>& vertices) {
+    auto first{ m_vertices.size() };
     m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
 
-    updateData();
+    upload(first, m_vertices.size() - first);
 }
 
 template <typename V>
-void VertexBuffer<V>::clear() {
-    m_vertices.clear();
+void VertexBuffer<V>::reserve(std::size_t capacity) {
+    if (capacity <= m_capacity) return;
 
-    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+    bind();
+
+    m_capacity = capacity;
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(m_capacity * sizeof(V)),
+                 nullptr,
+                 toGLUsage(m_usage));
     openGLCheck();
+
+    upload(0, m_vertices.size());
+}
+
+template <typename V>
+void VertexBuffer<V>::resize(std::size_t size) {
+    auto first{ m_vertices.size() };
+    m_vertices.resize(size);
+
+    if (size > first) upload(first, size - first);
+}
+
+template <typename V>
+void VertexBuffer<V>::clear() {
+    // The storage is kept for the next data.
+    m_vertices.clear();
 }
 
 template <typename V>
 void VertexBuffer<V>::bind() const {
-    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
-    openGLCheck();
+    RenderState::getInstance().bindArrayBuffer(m_vertexBuffer);
 }
 
 template <typename V>
@@ -92,74 +178,135 @@ std::size_t VertexBuffer<V>::size() const noexcept {
     return m_vertices.size();
 }
 
+template <typename V>
+std::size_t VertexBuffer<V>::capacity() const noexcept {
+    return m_capacity;
+}
+
+template <typename V>
+const std::vector<V>& VertexBuffer<V>::getData() const noexcept {
+    return m_vertices;
+}
+
+template <typename V>
+std::uint32_t VertexBuffer<V>::operator*() const noexcept {
+    return m_vertexBuffer;
+}
+
 template <typename V>
 VertexBuffer<V>::~VertexBuffer() {
+    RenderState::getInstance().forgetBuffer(m_vertexBuffer);
     glDeleteBuffers(1, &m_vertexBuffer);
 }
 
+template <typename V>
+void VertexBuffer<V>::upload(std::size_t first, std::size_t count) {
+    bind();
+
+    uploadRange(GL_ARRAY_BUFFER,
+                m_usage,
+                m_capacity,
+                m_vertices.data(),
+                sizeof(V),
+                m_vertices.size(),
+                first,
+                count);
+}
+
 template <typename T>
-IndexBuffer<T>::IndexBuffer(std::vector<T>&& indices) : m_indices{ std::move(indices) } {
+IndexBuffer<T>::IndexBuffer(std::vector<T>&& indices, BufferUsage usage)
+    : m_indices{ std::move(indices) }, m_usage{ usage } {
     glGenBuffers(1, &m_indexBuffer);
     openGLCheck();
 
-    updateData();
+    upload(0, m_indices.size());
 }
 
 template <typename T>
-IndexBuffer<T>::IndexBuffer(const std::vector<T>& indices) : m_indices{ indices } {
+IndexBuffer<T>::IndexBuffer(const std::vector<T>& indices, BufferUsage usage)
+    : m_indices{ indices }, m_usage{ usage } {
     glGenBuffers(1, &m_indexBuffer);
     openGLCheck();
 
-    updateData();
+    upload(0, m_indices.size());
 }
 
 template <typename T>
 void IndexBuffer<T>::updateData(std::vector<T>&& indices) {
     m_indices = std::move(indices);
-    updateData();
+    upload(0, m_indices.size());
 }
 
 template <typename T>
 void IndexBuffer<T>::updateData(const std::vector<T>& indices) {
     m_indices = indices;
-    updateData();
+    upload(0, m_indices.size());
 }
 
 template <typename T>
-void IndexBuffer<T>::updateData() const {
-    bind();
+void IndexBuffer<T>::updateData(std::size_t first, std::span<const T> indices) {
+    if (first > m_indices.size())
+        throw std::runtime_error{ "Error : IndexBuffer::updateData : first is past the end"s };
 
-    glBufferData(
-        GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(T), m_indices.data(), GL_STATIC_DRAW);
-    openGLCheck();
+    if (first + indices.size() > m_indices.size()) m_indices.resize(first + indices.size());
+    std::ranges::copy(indices, m_indices.begin() + static_cast<std::ptrdiff_t>(first));
+
+    upload(first, indices.size());
 }
 
 template <typename T>
 void IndexBuffer<T>::addData(std::vector<T>&& indices) {
+    auto first{ m_indices.size() };
     m_indices.insert(m_indices.end(),
                      std::make_move_iterator(indices.begin()),
                      std::make_move_iterator(indices.end()));
-    updateData();
+
+    upload(first, m_indices.size() - first);
 }
 
 template <typename T>
 void IndexBuffer<T>::addData(const std::vector<T>& indices) {
+    auto first{ m_indices.size() };
     m_indices.insert(m_indices.end(), indices.begin(), indices.end());
-    updateData();
+
+    upload(first, m_indices.size() - first);
 }
 
 template <typename T>
-void IndexBuffer<T>::clear() {
-    m_indices.clear();
+void IndexBuffer<T>::reserve(std::size_t capacity) {
+    if (capacity <= m_capacity) return;
 
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+    // The element array binding belongs to the bound vertex array, which must not be a mesh.
+    RenderState::getInstance().bindDefaultVertexArray();
+    bind();
+
+    m_capacity = capacity;
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(m_capacity * sizeof(T)),
+                 nullptr,
+                 toGLUsage(m_usage));
     openGLCheck();
+
+    upload(0, m_indices.size());
+}
+
+template <typename T>
+void IndexBuffer<T>::resize(std::size_t size) {
+    auto first{ m_indices.size() };
+    m_indices.resize(size);
+
+    if (size > first) upload(first, size - first);
+}
+
+template <typename T>
+void IndexBuffer<T>::clear() {
+    // The storage is kept for the next data.
+    m_indices.clear();
 }
 
 template <typename T>
 void IndexBuffer<T>::bind() const {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
-    openGLCheck();
+    RenderState::getInstance().bindElementArrayBuffer(m_indexBuffer);
 }
 
 template <typename T>
@@ -167,13 +314,46 @@ std::size_t IndexBuffer<T>::size() const noexcept {
     return m_indices.size();
 }
 
+template <typename T>
+std::size_t IndexBuffer<T>::capacity() const noexcept {
+    return m_capacity;
+}
+
+template <typename T>
+const std::vector<T>& IndexBuffer<T>::getData() const noexcept {
+    return m_indices;
+}
+
+template <typename T>
+std::uint32_t IndexBuffer<T>::operator*() const noexcept {
+    return m_indexBuffer;
+}
+
 template <typename T>
 IndexBuffer<T>::~IndexBuffer() {
+    RenderState::getInstance().forgetBuffer(m_indexBuffer);
     glDeleteBuffers(1, &m_indexBuffer);
 }
 
+template <typename T>
+void IndexBuffer<T>::upload(std::size_t first, std::size_t count) {
+    // The element array binding belongs to the bound vertex array, which must not be a mesh.
+    RenderState::getInstance().bindDefaultVertexArray();
+    bind();
+
+    uploadRange(GL_ELEMENT_ARRAY_BUFFER,
+                m_usage,
+                m_capacity,
+                m_indices.data(),
+                sizeof(T),
+                m_indices.size(),
+                first,
+                count);
+}
+
 template class VertexBuffer<Vertex>;
 template class VertexBuffer<Vertex2>;
+template class VertexBuffer<Instance2>;
 
 template class IndexBuffer<std::uint8_t>;
 template class IndexBuffer<std::uint16_t>;
@@ -0,0 +1,51 @@
+#include "camera_block.hxx"
+
+#include <glad/glad.h>
+
+#include "opengl_check.hxx"
+#include "shader_program.hxx"
+
+CameraBlock::CameraBlock() {
+    glGenBuffers(1, &m_buffer);
+    openGLCheck();
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, ShaderProgram::s_cameraBlockBinding, m_buffer);
+    openGLCheck();
+
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(Data), nullptr, GL_DYNAMIC_DRAW);
+    openGLCheck();
+
+    setViewMatrix(glm::mat3{ 1.0f });
+}
+
+CameraBlock::~CameraBlock() { glDeleteBuffers(1, &m_buffer); }
+
+void CameraBlock::setViewMatrix(const glm::mat3& viewMatrix) {
+    if (viewMatrix == m_viewMatrix) return;
+
+    m_viewMatrix = viewMatrix;
+    for (glm::length_t column{}; column < 3; ++column)
+        m_data.viewMatrix.at(static_cast<std::size_t>(column)) =
+            glm::vec4{ viewMatrix[column], 0.0f };
+
+    m_isDirty = true;
+}
+
+void CameraBlock::setScreenSize(const glm::vec2& screenSize) {
+    if (screenSize == m_data.screenSize) return;
+
+    m_data.screenSize = screenSize;
+    m_isDirty = true;
+}
+
+void CameraBlock::upload() {
+    if (!m_isDirty) return;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+    openGLCheck();
+
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Data), &m_data);
+    openGLCheck();
+
+    m_isDirty = false;
+}
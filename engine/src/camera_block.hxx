@@ -0,0 +1,43 @@
+#ifndef ENGINE_PREPARE_TO_GAME_CAMERA_BLOCK_HXX
+#define ENGINE_PREPARE_TO_GAME_CAMERA_BLOCK_HXX
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+
+// Per-frame data of the std140 "Camera" uniform block shared by every program.
+// Values are kept on the CPU and uploaded only before a draw that follows a change.
+class CameraBlock final
+{
+private:
+    // std140: a mat3 is stored as three vec4 columns.
+    struct Data
+    {
+        std::array<glm::vec4, 3> viewMatrix{};
+        glm::vec2 screenSize{};
+        glm::vec2 padding{};
+    };
+
+    static_assert(sizeof(Data) == 64);
+
+    std::uint32_t m_buffer{};
+    Data m_data{};
+    glm::mat3 m_viewMatrix{ 0.0f };
+    bool m_isDirty{ true };
+
+public:
+    CameraBlock();
+    ~CameraBlock();
+
+    CameraBlock(const CameraBlock&) = delete;
+    CameraBlock& operator=(const CameraBlock&) = delete;
+
+    void setViewMatrix(const glm::mat3& viewMatrix);
+    void setScreenSize(const glm::vec2& screenSize);
+
+    // Uploads pending changes to the buffer bound to ShaderProgram::s_cameraBlockBinding.
+    void upload();
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_CAMERA_BLOCK_HXX
@@ -0,0 +1,119 @@
+#include "dynamic_texture.hxx"
+
+#include <algorithm>
+#include <glad/glad.h>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "opengl_check.hxx"
+
+using namespace std::literals;
+
+DynamicTexture::DynamicTexture(std::size_t width, std::size_t height, Color color)
+    : m_width{ width }, m_height{ height }, m_pixels(width * height, color) {
+    if (m_width == 0 || m_height == 0)
+        throw std::runtime_error{ "Error : DynamicTexture::DynamicTexture : empty texture"s };
+
+    m_texture.load(m_pixels.data(), m_width, m_height);
+}
+
+void DynamicTexture::setPixel(std::size_t x, std::size_t y, Color color) {
+    if (x >= m_width || y >= m_height)
+        throw std::runtime_error{
+            "Error : DynamicTexture::setPixel : texel is out of the texture"s
+        };
+
+    auto& pixel{ m_pixels[y * m_width + x] };
+    if (pixel == color) return;
+
+    pixel = color;
+    markDirty(x, y);
+}
+
+void DynamicTexture::fill(Color color) {
+    std::ranges::fill(m_pixels, color);
+
+    m_dirtyRectangles.clear();
+    m_dirtyRectangles.push_back({ 0, m_width, 0, m_height });
+}
+
+DynamicTexture::Color DynamicTexture::getPixel(std::size_t x, std::size_t y) const {
+    if (x >= m_width || y >= m_height)
+        throw std::runtime_error{
+            "Error : DynamicTexture::getPixel : texel is out of the texture"s
+        };
+
+    return m_pixels[y * m_width + x];
+}
+
+std::size_t DynamicTexture::upload() {
+    if (m_dirtyRectangles.empty()) return 0;
+
+    m_texture.bind();
+
+    // Every rectangle is read out of the whole image, row by row.
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(m_width));
+    openGLCheck();
+
+    std::size_t bytes{};
+    for (const auto& rectangle : m_dirtyRectangles) {
+        auto width{ rectangle.lastX - rectangle.firstX };
+        auto height{ rectangle.lastY - rectangle.firstY };
+
+        glTexSubImage2D(GL_TEXTURE_2D,
+                        0,
+                        static_cast<GLint>(rectangle.firstX),
+                        static_cast<GLint>(rectangle.firstY),
+                        static_cast<GLsizei>(width),
+                        static_cast<GLsizei>(height),
+                        GL_RGBA,
+                        GL_UNSIGNED_BYTE,
+                        m_pixels.data() + rectangle.firstY * m_width + rectangle.firstX);
+        openGLCheck();
+
+        bytes += width * height * sizeof(Color);
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    openGLCheck();
+
+    m_dirtyRectangles.clear();
+    return bytes;
+}
+
+std::size_t DynamicTexture::getWidth() const noexcept { return m_width; }
+
+std::size_t DynamicTexture::getHeight() const noexcept { return m_height; }
+
+Texture& DynamicTexture::getTexture() noexcept { return m_texture; }
+
+void DynamicTexture::markDirty(std::size_t x, std::size_t y) {
+    auto getArea{ [](const DirtyRectangle& rectangle) {
+        return (rectangle.lastX - rectangle.firstX) * (rectangle.lastY - rectangle.firstY);
+    } };
+    auto getUnion{ [x, y](const DirtyRectangle& rectangle) {
+        return DirtyRectangle{ std::min(rectangle.firstX, x),
+                               std::max(rectangle.lastX, x + 1),
+                               std::min(rectangle.firstY, y),
+                               std::max(rectangle.lastY, y + 1) };
+    } };
+
+    // The texel joins the rectangle it grows least, or starts a new one if that
+    // would send too many unchanged texels and there is room for another.
+    DirtyRectangle* nearest{};
+    auto nearestGrowth{ std::numeric_limits<std::size_t>::max() };
+    for (auto& rectangle : m_dirtyRectangles) {
+        auto growth{ getArea(getUnion(rectangle)) - getArea(rectangle) };
+        if (growth < nearestGrowth) {
+            nearest = &rectangle;
+            nearestGrowth = growth;
+        }
+    }
+
+    if (nearest &&
+        (nearestGrowth <= s_mergeSlack || m_dirtyRectangles.size() == s_maxDirtyRectangles))
+        *nearest = getUnion(*nearest);
+    else
+        m_dirtyRectangles.push_back({ x, x + 1, y, y + 1 });
+}
@@ -12,12 +12,17 @@
 #include <optional>
 #include <stdexcept>
 #include <thread>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
+#include "camera_block.hxx"
 #include "hot_reload_provider.hxx"
 #include "imgui_impl_opengl3.hxx"
 #include "imgui_impl_sdl3.hxx"
 #include "opengl_check.hxx"
+#include "render_state.hxx"
+#include "render_queue.hxx"
 
 #ifndef __ANDROID__
 
@@ -322,6 +327,20 @@ Event::Keyboard::Key ImGuiKeyToEventKey(ImGuiKey key) {
     }
 }
 
+void ImGuiImage(const Texture& texture, const ImVec2& size) {
+    // The ImGui backend blends straight alpha, so the image gets its own blend
+    // state and the backend restores the usual one after it.
+    auto drawList{ ImGui::GetWindowDrawList() };
+    drawList->AddCallback(
+        [](const ImDrawList*, const ImDrawCmd*) {
+            glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            openGLCheck();
+        },
+        nullptr);
+    ImGui::Image(reinterpret_cast<ImTextureID>(*texture), size);
+    drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+}
+
 std::ifstream& operator>>(std::ifstream& in, Triangle& triangle) {
     for (auto& vertex : triangle.vertices)
         in >> vertex;
@@ -572,11 +591,27 @@ private:
 
     ShaderProgram m_shaderProgram{};
     ShaderProgram m_shaderProgramWithView{};
+    ShaderProgram m_shaderProgramInstanced{};
+    ShaderProgram m_shaderProgramInstancedOpaque{};
+    ShaderProgram m_shaderProgramTilemap{};
 
     std::reference_wrapper<ShaderProgram> m_program{ m_shaderProgram };
 
+    std::unique_ptr<CameraBlock> m_cameraBlock{};
+
+    Framebuffer* m_renderTarget{};
+
+    RenderQueue m_renderQueue{};
+    // Holds what was submitted for the window while a render target is being drawn.
+    RenderQueue m_pausedRenderQueue{};
+    std::unique_ptr<VertexBuffer<Vertex2>> m_unitQuadVertexBuffer{};
+    std::unique_ptr<IndexBuffer<std::uint16_t>> m_unitQuadIndexBuffer{};
+    std::unique_ptr<Mesh<Vertex2, std::uint16_t>> m_unitQuadMesh{};
+
     std::vector<std::reference_wrapper<Audio>> m_sounds{};
 
+    RenderStatistics m_renderStatistics{};
+
     int m_framerate{ 150 };
     bool m_isEnd{};
 
@@ -614,6 +649,23 @@ public:
                 const glm::mat3& matrix,
                 const View& view) override;
 
+    void render(const Mesh<Vertex2, std::uint16_t>& mesh,
+                const Texture& texture,
+                const glm::mat3& matrix,
+                const View& view,
+                std::uint8_t layer,
+                BlendMode blendMode) override;
+
+    void render(const Tilemap& tilemap,
+                const glm::mat3& matrix,
+                const View& view,
+                std::uint8_t layer,
+                BlendMode blendMode) override;
+
+    void beginRenderTarget(Framebuffer& framebuffer) override;
+
+    void endRenderTarget() override;
+
     void render(const Sprite& sprite) override;
 
     void render(const Sprite& sprite, const View& view) override;
@@ -635,6 +687,10 @@ public:
     void setFramerate(int framerate) override { m_framerate = framerate; }
     [[nodiscard]] int getFramerate() const noexcept override { return m_framerate; }
 
+    [[nodiscard]] RenderStatistics getRenderStatistics() const noexcept override {
+        return m_renderStatistics;
+    }
+
     [[nodiscard]] ImGuiContext* getImGuiContext() const noexcept override {
         return ImGui::GetCurrentContext();
     }
@@ -711,6 +767,23 @@ private:
             throw std::runtime_error{ "Error : createGLContext : bad gladLoad"s };
     }
 
+    template <typename T>
+    void drawElements(const ShaderProgram& program,
+                      const VertexBuffer<Vertex2>& vertexBuffer,
+                      const IndexBuffer<T>& indexBuffer,
+                      const Texture& texture,
+                      std::size_t firstIndex,
+                      std::size_t indexCount);
+
+    void flushQueue();
+
+    template <typename T>
+    void drawMesh(const ShaderProgram& program,
+                  const Mesh<Vertex2, T>& mesh,
+                  const Texture& texture,
+                  std::size_t firstIndex,
+                  std::size_t indexCount);
+
     static void audioCallback(void* engine_ptr, std::uint8_t* stream, int streamSize);
 };
 
@@ -721,9 +794,14 @@ std::string EngineImpl::initialize(std::string_view config) {
 
     initSDL();
 
+#ifdef ENGINE_GL_CHECKS
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS,
+                        SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG | // Always required on Mac
+                            SDL_GL_CONTEXT_DEBUG_FLAG);
+#else
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS,
                         SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG); // Always required on Mac
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_DEBUG_FLAG);
+#endif
 
 #ifndef __ANDROID__
 
@@ -752,6 +830,12 @@ std::string EngineImpl::initialize(std::string_view config) {
                         ? jsonValue.as_object().at("window_min_height").as_int64()
                         : 480 };
 
+    auto glDebugSeverity{ jsonValue.as_object().contains("gl_debug_severity")
+                              ? std::string_view{ jsonValue.as_object()
+                                                      .at("gl_debug_severity")
+                                                      .as_string() }
+                              : "medium"sv };
+
     int flags{};
     flags |= SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN;
     if (isWindowResizable) flags |= SDL_WINDOW_RESIZABLE;
@@ -768,24 +852,55 @@ std::string EngineImpl::initialize(std::string_view config) {
 #else
     const SDL_DisplayMode* displayMode{ SDL_GetCurrentDisplayMode(1) };
     m_window = createWindow("android", displayMode->w, displayMode->h, SDL_WINDOW_OPENGL);
+
+    auto glDebugSeverity{ "medium"sv };
 #endif
 
     createGLContext();
 
+    static const std::unordered_map<std::string_view, OpenGLDebugSeverity> debugSeverities{
+        { "notification", OpenGLDebugSeverity::notification },
+        { "low", OpenGLDebugSeverity::low },
+        { "medium", OpenGLDebugSeverity::medium },
+        { "high", OpenGLDebugSeverity::high }
+    };
+
+    auto debugSeverity{ debugSeverities.find(glDebugSeverity) };
+    if (debugSeverity == debugSeverities.end())
+        throw std::runtime_error{ "Error : EngineImpl::initialize : unknown GL debug severity "s +
+                                  std::string{ glDebugSeverity } };
+
+    if (!enableOpenGLDebugOutput(debugSeverity->second))
+        std::cout << "GL debug output is not supported, errors are polled"sv << std::endl;
+
     glEnable(GL_DEPTH_TEST);
     openGLCheck();
 
-    glEnable(GL_BLEND);
+    // Draws of one layer share the depth, the later one is drawn on top.
+    glDepthFunc(GL_LEQUAL);
     openGLCheck();
 
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Textures hold colours premultiplied by alpha, see decodeImage.
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
     openGLCheck();
 
+    // Vertex array of the draws that pass loose buffers instead of a mesh.
     glGenVertexArrays(1, &m_verticesArray);
     openGLCheck();
 
-    glBindVertexArray(m_verticesArray);
-    openGLCheck();
+    RenderState::getInstance().setDefaultVertexArray(m_verticesArray);
+    RenderState::getInstance().bindDefaultVertexArray();
+
+    const auto& unitQuadVertices{ Sprite::getUnitQuadVertices() };
+    const auto& unitQuadIndices{ Sprite::getUnitQuadIndices() };
+    m_unitQuadVertexBuffer = std::make_unique<VertexBuffer<Vertex2>>(
+        std::vector<Vertex2>{ unitQuadVertices.begin(), unitQuadVertices.end() });
+    m_unitQuadIndexBuffer = std::make_unique<IndexBuffer<std::uint16_t>>(
+        std::vector<std::uint16_t>{ unitQuadIndices.begin(), unitQuadIndices.end() });
+    m_unitQuadMesh = std::make_unique<Mesh<Vertex2, std::uint16_t>>(*m_unitQuadVertexBuffer,
+                                                                    *m_unitQuadIndexBuffer);
+
+    m_cameraBlock = std::make_unique<CameraBlock>();
 
     m_audioSpec.freq = 48000;
     m_audioSpec.format = SDL_AUDIO_S16LSB;
@@ -848,11 +963,24 @@ std::string EngineImpl::initialize(std::string_view config) {
 
 void EngineImpl::uninitialize() {
     SDL_CloseAudioDevice(m_audioDevice);
+    // Shared assets still in use are released by their last user.
+    AssetRegistry::getInstance().clear();
+    m_renderQueue.clear();
+    m_pausedRenderQueue.clear();
+    m_unitQuadMesh.reset();
+    m_unitQuadVertexBuffer.reset();
+    m_unitQuadIndexBuffer.reset();
+    m_cameraBlock.reset();
+
+    RenderState::getInstance().forgetVertexArray(m_verticesArray);
     glDeleteVertexArrays(1, &m_verticesArray);
     openGLCheck();
 
     m_shaderProgram.clear();
     m_shaderProgramWithView.clear();
+    m_shaderProgramInstanced.clear();
+    m_shaderProgramInstancedOpaque.clear();
+    m_shaderProgramTilemap.clear();
 
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL3_Shutdown();
@@ -911,16 +1039,30 @@ bool EngineImpl::readInput(Event& event) {
 }
 
 void EngineImpl::swapBuffers() {
+    flushQueue();
+
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
+    // ImGui binds its own objects and restores ours with plain GL calls.
+    auto& renderState{ RenderState::getInstance() };
+    renderState.invalidate();
+    m_renderStatistics = { .issuedStateCalls = renderState.getCounters().issued,
+                           .elidedStateCalls = renderState.getCounters().elided };
+    renderState.resetCounters();
+
     int width{}, height{};
     SDL_GetWindowSizeInPixels(m_window, &width, &height);
     glViewport(0, 0, width, height);
     openGLCheck();
 
+    m_cameraBlock->setScreenSize({ static_cast<float>(width), static_cast<float>(height) });
+
     SDL_GL_SwapWindow(m_window);
 
+    // The depth buffer is only cleared while depth writes are on.
+    renderState.setDepthWrite(true);
+
     glClearColor(0.0f, 0.0f, 0.f, 1.f);
     openGLCheck();
 
@@ -937,12 +1079,33 @@ void EngineImpl::recompileShaders() {
     m_shaderProgramWithView.recompileShaders(
         HotReloadProvider::getInstance().getPath("vertex_shader_with_view"),
         HotReloadProvider::getInstance().getPath("fragment_shader"));
+
+    m_shaderProgramInstanced.recompileShaders(
+        HotReloadProvider::getInstance().getPath("vertex_shader_instanced"),
+        HotReloadProvider::getInstance().getPath("fragment_shader"));
+
+    m_shaderProgramInstancedOpaque.recompileShaders(
+        HotReloadProvider::getInstance().getPath("vertex_shader_instanced"),
+        HotReloadProvider::getInstance().getPath("fragment_shader_opaque"));
+
+    m_shaderProgramTilemap.recompileShaders(
+        HotReloadProvider::getInstance().getPath("vertex_shader_tilemap"),
+        HotReloadProvider::getInstance().getPath("fragment_shader_tilemap"));
 #else
     m_shaderProgram.recompileShaders("data/shaders/vertex_shader_without_view.vert",
                                      "data/shaders/fragment_shader.frag");
 
     m_shaderProgramWithView.recompileShaders("data/shaders/vertex_shader_with_view.vert",
                                              "data/shaders/fragment_shader.frag");
+
+    m_shaderProgramInstanced.recompileShaders("data/shaders/vertex_shader_instanced.vert",
+                                              "data/shaders/fragment_shader.frag");
+
+    m_shaderProgramInstancedOpaque.recompileShaders("data/shaders/vertex_shader_instanced.vert",
+                                                    "data/shaders/fragment_shader_opaque.frag");
+
+    m_shaderProgramTilemap.recompileShaders("data/shaders/vertex_shader_tilemap.vert",
+                                            "data/shaders/fragment_shader_tilemap.frag");
 #endif
     m_program.get().use();
 }
@@ -950,136 +1113,231 @@ void EngineImpl::recompileShaders() {
 void EngineImpl::render(const VertexBuffer<Vertex2>& vertexBuffer,
                         const IndexBuffer<std::uint16_t>& indexBuffer,
                         const Texture& texture) {
+    flushQueue();
+    drawElements(m_program.get(), vertexBuffer, indexBuffer, texture, 0, indexBuffer.size());
+}
+
+void EngineImpl::render(const VertexBuffer<Vertex2>& vertexBuffer,
+                        const IndexBuffer<std::uint32_t>& indexBuffer,
+                        const Texture& texture) {
+    flushQueue();
+    drawElements(m_program.get(), vertexBuffer, indexBuffer, texture, 0, indexBuffer.size());
+}
+
+void EngineImpl::render(const VertexBuffer<Vertex2>& vertexBuffer,
+                        const IndexBuffer<std::uint32_t>& indexBuffer,
+                        const Texture& texture,
+                        const glm::mat3& matrix) {
+    flushQueue();
     m_program.get().use();
-    m_program.get().setUniform("texSampler", texture);
+    m_program.get().setUniform("matrix", matrix);
+    render(vertexBuffer, indexBuffer, texture);
+}
 
-    texture.bind();
-    vertexBuffer.bind();
-    indexBuffer.bind();
+void EngineImpl::render(const VertexBuffer<Vertex2>& vertexBuffer,
+                        const IndexBuffer<std::uint32_t>& indexBuffer,
+                        const Texture& texture,
+                        const glm::mat3& matrix,
+                        const View& view) {
+    flushQueue();
+    ShaderProgram& lastProgram{ m_program.get() };
+    m_program = m_shaderProgramWithView;
+    m_cameraBlock->setViewMatrix(view.getViewMatrix());
+    render(vertexBuffer, indexBuffer, texture, matrix);
+    m_program = lastProgram;
+}
 
-    glEnableVertexAttribArray(0);
-    openGLCheck();
+void EngineImpl::render(const Mesh<Vertex2, std::uint16_t>& mesh,
+                        const Texture& texture,
+                        const glm::mat3& matrix,
+                        const View& view,
+                        std::uint8_t layer,
+                        BlendMode blendMode) {
+    const auto& program{ !mesh.isInstanced()             ? m_shaderProgramWithView
+                         : blendMode == BlendMode::opaque ? m_shaderProgramInstancedOpaque
+                                                          : m_shaderProgramInstanced };
+    m_renderQueue.add(program, mesh, texture, matrix, view, layer, blendMode);
+}
 
-    glEnableVertexAttribArray(1);
-    openGLCheck();
+void EngineImpl::render(const Tilemap& tilemap,
+                        const glm::mat3& matrix,
+                        const View& view,
+                        std::uint8_t layer,
+                        BlendMode blendMode) {
+    m_renderQueue.add(m_shaderProgramTilemap, tilemap, matrix, view, layer, blendMode);
+}
 
-    glEnableVertexAttribArray(2);
-    openGLCheck();
+void EngineImpl::beginRenderTarget(Framebuffer& framebuffer) {
+    if (m_renderTarget)
+        throw std::runtime_error{ "Error : EngineImpl::beginRenderTarget : already rendering "
+                                  "to a target"s };
+
+    // Draws already submitted for the window wait until the target is done.
+    std::swap(m_renderQueue, m_pausedRenderQueue);
+    m_renderTarget = &framebuffer;
+    framebuffer.bind();
 
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex2), nullptr);
+    glViewport(0,
+               0,
+               static_cast<GLsizei>(framebuffer.getWidth()),
+               static_cast<GLsizei>(framebuffer.getHeight()));
     openGLCheck();
 
-    glVertexAttribPointer(1,
-                          2,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(Vertex2),
-                          reinterpret_cast<const GLvoid*>(offsetof(Vertex2, texX)));
+    // The depth buffer is only cleared while depth writes are on.
+    RenderState::getInstance().setDepthWrite(true);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     openGLCheck();
 
-    glVertexAttribPointer(2,
-                          4,
-                          GL_UNSIGNED_BYTE,
-                          GL_FALSE,
-                          sizeof(Vertex2),
-                          reinterpret_cast<const GLvoid*>(offsetof(Vertex2, rgba)));
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     openGLCheck();
+}
+
+void EngineImpl::endRenderTarget() {
+    if (!m_renderTarget)
+        throw std::runtime_error{ "Error : EngineImpl::endRenderTarget : no render target"s };
+
+    flushQueue();
+    std::swap(m_renderQueue, m_pausedRenderQueue);
+    m_renderTarget = nullptr;
+    RenderState::getInstance().bindFramebuffer(0);
 
-    glDrawElements(
-        GL_TRIANGLES, static_cast<GLsizei>(indexBuffer.size()), GL_UNSIGNED_SHORT, nullptr);
+    int width{}, height{};
+    SDL_GetWindowSizeInPixels(m_window, &width, &height);
+    glViewport(0, 0, width, height);
     openGLCheck();
+}
+
+void EngineImpl::render(const Sprite& sprite) { m_renderQueue.add(m_program.get(), sprite); }
 
-    glDisableVertexAttribArray(0);
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(2);
+void EngineImpl::render(const Sprite& sprite, const View& view) {
+    m_renderQueue.add(m_shaderProgramWithView, sprite, view);
 }
 
-void EngineImpl::render(const VertexBuffer<Vertex2>& vertexBuffer,
-                        const IndexBuffer<std::uint32_t>& indexBuffer,
-                        const Texture& texture) {
-    m_program.get().use();
-    m_program.get().setUniform("texSampler", texture);
+template <typename T>
+void EngineImpl::drawElements(const ShaderProgram& program,
+                              const VertexBuffer<Vertex2>& vertexBuffer,
+                              const IndexBuffer<T>& indexBuffer,
+                              const Texture& texture,
+                              std::size_t firstIndex,
+                              std::size_t indexCount) {
+    static_assert(std::is_same_v<T, std::uint16_t> || std::is_same_v<T, std::uint32_t>);
+    constexpr GLenum indexType{ std::is_same_v<T, std::uint16_t> ? GL_UNSIGNED_SHORT
+                                                                 : GL_UNSIGNED_INT };
+
+    m_cameraBlock->upload();
+
+    // Immediate draws keep the blending and depth of the engine before the render queue.
+    auto& renderState{ RenderState::getInstance() };
+    renderState.setBlending(true);
+    renderState.setDepthWrite(true);
+
+    program.use();
+    program.setUniform("depth", 0.0f);
+    program.setUniform("texSampler", texture);
+
+    renderState.bindDefaultVertexArray();
 
-    texture.bind();
     vertexBuffer.bind();
     indexBuffer.bind();
 
-    glEnableVertexAttribArray(0);
-    openGLCheck();
+    renderState.setVertexLayout<Vertex2>();
+    renderState.setEnabledAttributes(RenderState::getAttributeMask<Vertex2>());
 
-    glEnableVertexAttribArray(1);
+    glDrawElements(GL_TRIANGLES,
+                   static_cast<GLsizei>(indexCount),
+                   indexType,
+                   reinterpret_cast<const GLvoid*>(firstIndex * sizeof(T)));
     openGLCheck();
+}
 
-    glEnableVertexAttribArray(2);
-    openGLCheck();
+template <typename T>
+void EngineImpl::drawMesh(const ShaderProgram& program,
+                          const Mesh<Vertex2, T>& mesh,
+                          const Texture& texture,
+                          std::size_t firstIndex,
+                          std::size_t indexCount) {
+    static_assert(std::is_same_v<T, std::uint16_t> || std::is_same_v<T, std::uint32_t>);
+    constexpr GLenum indexType{ std::is_same_v<T, std::uint16_t> ? GL_UNSIGNED_SHORT
+                                                                 : GL_UNSIGNED_INT };
 
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex2), nullptr);
-    openGLCheck();
+    m_cameraBlock->upload();
 
-    glVertexAttribPointer(1,
-                          2,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(Vertex2),
-                          reinterpret_cast<const GLvoid*>(offsetof(Vertex2, texX)));
-    openGLCheck();
+    program.use();
+    program.setUniform("texSampler", texture);
 
-    glVertexAttribPointer(2,
-                          4,
-                          GL_UNSIGNED_BYTE,
-                          GL_FALSE,
-                          sizeof(Vertex2),
-                          reinterpret_cast<const GLvoid*>(offsetof(Vertex2, rgba)));
-    openGLCheck();
+    mesh.bind();
 
-    glDrawElements(
-        GL_TRIANGLES, static_cast<GLsizei>(indexBuffer.size()), GL_UNSIGNED_INT, nullptr);
+    glDrawElements(GL_TRIANGLES,
+                   static_cast<GLsizei>(indexCount),
+                   indexType,
+                   reinterpret_cast<const GLvoid*>(firstIndex * sizeof(T)));
     openGLCheck();
-
-    glDisableVertexAttribArray(0);
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(2);
 }
 
-void EngineImpl::render(const VertexBuffer<Vertex2>& vertexBuffer,
-                        const IndexBuffer<std::uint32_t>& indexBuffer,
-                        const Texture& texture,
-                        const glm::mat3& matrix) {
-    m_program.get().use();
-    m_program.get().setUniform("matrix", matrix);
-    render(vertexBuffer, indexBuffer, texture);
-}
+void EngineImpl::flushQueue() {
+    m_renderQueue.flush([this](const RenderQueue::Batch& batch,
+                               const Mesh<Vertex2, std::uint32_t>& mesh) {
+        auto& renderState{ RenderState::getInstance() };
+        renderState.setBlending(batch.blendMode == BlendMode::alpha);
+        renderState.setDepthWrite(batch.blendMode == BlendMode::opaque);
 
-void EngineImpl::render(const VertexBuffer<Vertex2>& vertexBuffer,
-                        const IndexBuffer<std::uint32_t>& indexBuffer,
-                        const Texture& texture,
-                        const glm::mat3& matrix,
-                        const View& view) {
-    ShaderProgram& lastProgram{ m_program.get() };
-    m_program = m_shaderProgramWithView;
-    m_program.get().use();
-    m_program.get().setUniform("viewMatrix", view.getViewMatrix());
-    render(vertexBuffer, indexBuffer, texture, matrix);
-    m_program = lastProgram;
-}
+        batch.program->use();
+        batch.program->setUniform("depth", RenderQueue::getLayerDepth(batch.layer));
+        if (batch.viewMatrix) m_cameraBlock->setViewMatrix(*batch.viewMatrix);
 
-void EngineImpl::render(const Sprite& sprite) {
-    m_program.get().use();
-    m_program.get().setUniform("matrix", sprite.getResultMatrix());
+        if (batch.mesh) {
+            m_cameraBlock->upload();
 
-    VertexBuffer vertexBuffer{ sprite.getVertices() };
-    IndexBuffer indexBuffer{ sprite.getIndices() };
+            batch.program->setUniform("matrix", *batch.matrix);
+            batch.program->setUniform("texSampler", *batch.texture);
 
-    render(vertexBuffer, indexBuffer, sprite.getTexture());
-}
+            batch.mesh->bind();
 
-void EngineImpl::render(const Sprite& sprite, const View& view) {
-    ShaderProgram& lastProgram{ m_program.get() };
-    m_program = m_shaderProgramWithView;
-    m_program.get().use();
-    m_program.get().setUniform("viewMatrix", view.getViewMatrix());
-    render(sprite);
-    m_program = lastProgram;
+            glDrawElementsInstanced(GL_TRIANGLES,
+                                    static_cast<GLsizei>(batch.indexCount),
+                                    GL_UNSIGNED_SHORT,
+                                    nullptr,
+                                    static_cast<GLsizei>(batch.mesh->getInstanceCount()));
+            openGLCheck();
+            return;
+        }
+
+        if (batch.tilemap) {
+            m_cameraBlock->upload();
+
+            batch.program->setUniform("matrix", *batch.matrix);
+            batch.program->setUniform(
+                "gridSize",
+                glm::vec2{ static_cast<float>(batch.tilemap->getColumns()),
+                           static_cast<float>(batch.tilemap->getRows()) });
+            batch.tilemap->bind(batch.program->getSamplerUnit("tiles"),
+                                batch.program->getSamplerUnit("tileset"));
+
+            m_unitQuadMesh->bind();
+
+            glDrawElements(GL_TRIANGLES,
+                           static_cast<GLsizei>(batch.indexCount),
+                           GL_UNSIGNED_SHORT,
+                           nullptr);
+            openGLCheck();
+            return;
+        }
+
+        if (batch.matrix) {
+            batch.program->setUniform("matrix", *batch.matrix);
+            drawMesh(*batch.program,
+                     *m_unitQuadMesh,
+                     *batch.texture,
+                     batch.firstIndex,
+                     batch.indexCount);
+            return;
+        }
+
+        // Vertices of a batch are already transformed, only the view is left to the shader.
+        batch.program->setUniform("matrix", glm::mat3{ 1.0f });
+        drawMesh(*batch.program, mesh, *batch.texture, batch.firstIndex, batch.indexCount);
+    });
 }
 
 void EngineImpl::audioCallback(void* engine_ptr, std::uint8_t* stream, int streamSize) {
@@ -1215,12 +1473,16 @@ const EnginePtr& getEngineInstance() {
     return g_engine;
 }
 
-Audio::Audio(const fs::path& path) {
 #ifndef __WIN32__
-    SDL_RWops* file{ SDL_RWFromFile(path.c_str(), "rb") };
+Audio::Audio(const fs::path& path) : Audio{ SDL_RWFromFile(path.c_str(), "rb") } {}
 #else
-    SDL_RWops* file{ SDL_RWFromFile(path.string().c_str(), "rb") };
+Audio::Audio(const fs::path& path) : Audio{ SDL_RWFromFile(path.string().c_str(), "rb") } {}
 #endif
+
+Audio::Audio(std::span<const std::byte> file)
+    : Audio{ SDL_RWFromConstMem(file.data(), file.size()) } {}
+
+Audio::Audio(SDL_RWops* file) {
     if (file == nullptr) throw std::runtime_error{ "Error : Audio : failed read file"s };
 
     SDL_AudioSpec fileAudioSpec;
@@ -1261,6 +1523,16 @@ Audio::Audio(const fs::path& path) {
 }
 
 Audio::~Audio() {
+    // The mixer must not reach a sound that is gone, e.g. evicted from AssetRegistry.
+    // Sounds that outlive the engine have nothing to unregister from, and
+    // getEngineInstance would throw out of the destructor.
+    if (g_alreadyExist && g_engine) {
+        auto& sounds{ dynamic_cast<EngineImpl&>(*g_engine).m_sounds };
+
+        std::lock_guard lock{ g_audioMutex };
+        std::erase_if(sounds, [this](const Audio& sound) { return &sound == this; });
+    }
+
     if (m_start) SDL_free(m_start);
 }
 
@@ -1413,11 +1685,31 @@ int main(int argc, const char* argv[]) {
                 engine->recompileShaders();
             });
 
+            HotReloadProvider::getInstance().addToCheck("vertex_shader_instanced", [&]() {
+                std::cout << "recompile shaders\n"sv;
+                engine->recompileShaders();
+            });
+
             HotReloadProvider::getInstance().addToCheck("fragment_shader", [&]() {
                 std::cout << "recompile shaders\n"sv;
                 engine->recompileShaders();
             });
 
+            HotReloadProvider::getInstance().addToCheck("fragment_shader_opaque", [&]() {
+                std::cout << "recompile shaders\n"sv;
+                engine->recompileShaders();
+            });
+
+            HotReloadProvider::getInstance().addToCheck("vertex_shader_tilemap", [&]() {
+                std::cout << "recompile shaders\n"sv;
+                engine->recompileShaders();
+            });
+
+            HotReloadProvider::getInstance().addToCheck("fragment_shader_tilemap", [&]() {
+                std::cout << "recompile shaders\n"sv;
+                engine->recompileShaders();
+            });
+
             HotReloadProvider::getInstance().check();
 
             while (engine->isRunning()) {
@@ -0,0 +1,296 @@
+#include "file_reader.hxx"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef ENGINE_IO_URING
+#    include <cerrno>
+#    include <cstring>
+#    include <fcntl.h>
+#    include <liburing.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#ifndef __ANDROID__
+#    include <fstream>
+#else
+#    include <SDL3/SDL.h>
+#endif
+
+using namespace std::literals;
+
+#ifdef ENGINE_IO_URING
+
+struct FileReader::Ring
+{
+    // Reads in flight at once, later ones wait for a free slot.
+    inline static constexpr unsigned s_depth{ 64 };
+
+    struct Read
+    {
+        Request request{};
+        int descriptor{ -1 };
+        std::vector<std::byte> data{};
+        std::size_t doneSize{};
+    };
+
+    io_uring ring{};
+
+    Ring() {
+        // Kernels without io_uring, or sandboxes that forbid it, fail here.
+        if (auto result{ io_uring_queue_init(s_depth, &ring, 0) }; result < 0)
+            throw std::runtime_error{ "Error : FileReader::Ring : can't set up io_uring: "s +
+                                      std::strerror(-result) };
+    }
+
+    ~Ring() { io_uring_queue_exit(&ring); }
+
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    // Queues a read of the rest of the file. A read in flight holds at most one
+    // entry, so there is always one free while fewer than s_depth are in flight.
+    void prepare(Read& read) {
+        auto sqe{ io_uring_get_sqe(&ring) };
+
+        auto size{ std::min<std::size_t>(read.data.size() - read.doneSize, 1u << 30) };
+
+        io_uring_prep_read(sqe,
+                           read.descriptor,
+                           read.data.data() + read.doneSize,
+                           static_cast<unsigned>(size),
+                           read.doneSize);
+        io_uring_sqe_set_data(sqe, &read);
+    }
+};
+
+#else
+
+struct FileReader::Ring
+{
+};
+
+#endif
+
+static std::vector<std::byte> readWholeFile(const fs::path& path) {
+#ifndef __ANDROID__
+    std::ifstream in{ path, std::ios::binary | std::ios::ate };
+    if (!in.is_open())
+        throw std::runtime_error{ "Error : readWholeFile : bad open file "s + path.string() };
+
+    std::vector<std::byte> data(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+
+    if (!in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+        throw std::runtime_error{ "Error : readWholeFile : can't read all content from file "s +
+                                  path.string() };
+
+    return data;
+#else
+    SDL_RWops* io{ SDL_RWFromFile(path.c_str(), "rb") };
+    if (io == nullptr)
+        throw std::runtime_error{ "Error : readWholeFile : bad load file "s + path.string() };
+
+    Sint64 fileSize{ io->size(io) };
+    if (fileSize == -1) {
+        io->close(io);
+        throw std::runtime_error{ "Error : readWholeFile : can't determine size of file "s +
+                                  path.string() };
+    }
+
+    std::vector<std::byte> data(static_cast<std::size_t>(fileSize));
+    auto readSize{ io->read(io, data.data(), data.size()) };
+    io->close(io);
+
+    if (readSize != data.size())
+        throw std::runtime_error{ "Error : readWholeFile : can't read all content from file "s +
+                                  path.string() };
+
+    return data;
+#endif
+}
+
+FileReader::FileReader(std::size_t threadCount) {
+    if (threadCount == 0)
+        throw std::runtime_error{ "Error : FileReader::FileReader : no reader threads"s };
+
+#ifdef ENGINE_IO_URING
+    try {
+        m_ring = std::make_unique<Ring>();
+        m_threads.emplace_back(&FileReader::runRing, this);
+        return;
+    }
+    catch (const std::runtime_error&) {
+        m_ring.reset();
+    }
+#endif
+
+    for (std::size_t i{}; i < threadCount; ++i)
+        m_threads.emplace_back(&FileReader::runPool, this);
+}
+
+FileReader::~FileReader() {
+    {
+        std::lock_guard lock{ m_mutex };
+        m_isStopping = true;
+    }
+
+    m_condition.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+void FileReader::read(fs::path path, Callback callback) {
+    std::lock_guard lock{ m_mutex };
+    m_queued.push_back({ .path = std::move(path), .callback = std::move(callback) });
+}
+
+void FileReader::submit() {
+    {
+        std::lock_guard lock{ m_mutex };
+        if (m_queued.empty()) return;
+
+        std::ranges::move(m_queued, std::back_inserter(m_submitted));
+        m_queued.clear();
+    }
+
+    m_condition.notify_all();
+}
+
+bool FileReader::isUsingIoUring() const noexcept { return m_ring != nullptr; }
+
+void FileReader::runPool() {
+    std::unique_lock lock{ m_mutex };
+
+    while (true) {
+        m_condition.wait(lock, [this] { return m_isStopping || !m_submitted.empty(); });
+        if (m_isStopping) return;
+
+        auto request{ std::move(m_submitted.front()) };
+        m_submitted.pop_front();
+        lock.unlock();
+
+        std::vector<std::byte> data{};
+        std::exception_ptr error{};
+        try {
+            data = readWholeFile(request.path);
+        }
+        catch (const std::exception&) {
+            error = std::current_exception();
+        }
+
+        request.callback(std::move(data), error);
+        lock.lock();
+    }
+}
+
+#ifdef ENGINE_IO_URING
+
+void FileReader::runRing() {
+    auto& ring{ m_ring->ring };
+    std::size_t inFlightCount{};
+
+    auto fail{ [](Ring::Read& read, std::string_view message) {
+        if (read.descriptor != -1) ::close(read.descriptor);
+
+        auto error{ std::make_exception_ptr(
+            std::runtime_error{ "Error : FileReader : "s + std::string{ message } + ": "s +
+                                read.request.path.string() }) };
+        read.request.callback({}, error);
+    } };
+
+    while (true) {
+        std::vector<Request> batch{};
+        {
+            std::unique_lock lock{ m_mutex };
+            if (inFlightCount == 0)
+                m_condition.wait(lock, [this] { return m_isStopping || !m_submitted.empty(); });
+
+            if (m_isStopping && inFlightCount == 0) return;
+
+            // New batches wait for a completion when the ring is busy.
+            while (!m_isStopping && !m_submitted.empty() &&
+                   inFlightCount + batch.size() < Ring::s_depth) {
+                batch.push_back(std::move(m_submitted.front()));
+                m_submitted.pop_front();
+            }
+        }
+
+        for (auto& request : batch) {
+            auto read{ std::make_unique<Ring::Read>(Ring::Read{ .request = std::move(request) }) };
+
+            read->descriptor = ::open(read->request.path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (read->descriptor == -1) {
+                fail(*read, "can't open file"sv);
+                continue;
+            }
+
+            struct stat status{};
+            if (::fstat(read->descriptor, &status) == -1) {
+                fail(*read, "can't get file size"sv);
+                continue;
+            }
+
+            if (status.st_size == 0) {
+                ::close(read->descriptor);
+                read->request.callback({}, nullptr);
+                continue;
+            }
+
+            read->data.resize(static_cast<std::size_t>(status.st_size));
+            m_ring->prepare(*read);
+            ++inFlightCount;
+            // Owned by the ring until its completion.
+            read.release();
+        }
+
+        // The whole batch goes to the kernel with one system call.
+        if (!batch.empty()) io_uring_submit(&ring);
+        if (inFlightCount == 0) continue;
+
+        io_uring_cqe* cqe{};
+        if (io_uring_wait_cqe(&ring, &cqe) < 0) continue;
+
+        bool hasMore{};
+        do {
+            std::unique_ptr<Ring::Read> read{
+                static_cast<Ring::Read*>(io_uring_cqe_get_data(cqe))
+            };
+            auto result{ cqe->res };
+            io_uring_cqe_seen(&ring, cqe);
+
+            if (result == -EINTR || result == -EAGAIN || result > 0) {
+                if (result > 0) read->doneSize += static_cast<std::size_t>(result);
+
+                // Short reads continue where they stopped.
+                if (read->doneSize < read->data.size()) {
+                    m_ring->prepare(*read);
+                    read.release();
+                    hasMore = true;
+                    continue;
+                }
+
+                ::close(read->descriptor);
+                read->request.callback(std::move(read->data), nullptr);
+            }
+            else {
+                fail(*read, result == 0 ? "file is truncated"sv : std::strerror(-result));
+            }
+
+            --inFlightCount;
+        } while (io_uring_peek_cqe(&ring, &cqe) == 0);
+
+        if (hasMore) io_uring_submit(&ring);
+    }
+}
+
+#else
+
+void FileReader::runRing() {}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef ENGINE_PREPARE_TO_GAME_FILE_READER_HXX
+#define ENGINE_PREPARE_TO_GAME_FILE_READER_HXX
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Reads whole files in the background. read() queues a file and submit() starts
+// every file queued since the last call as one batch. Built with ENGINE_IO_URING,
+// a batch is one io_uring submission with a read per file, so a loading phase
+// waits for the disk rather than for a chain of blocking syscalls; the completions
+// are reaped by one thread. Without it, or where the kernel refuses io_uring,
+// a pool of threads does blocking reads instead. Callbacks run on those threads
+// and get the contents or the error of the read; they must not throw.
+class FileReader final
+{
+public:
+    using Callback = std::function<void(std::vector<std::byte>&& data, std::exception_ptr error)>;
+
+private:
+    struct Request
+    {
+        fs::path path{};
+        Callback callback{};
+    };
+
+    struct Ring;
+
+    std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+    std::vector<Request> m_queued{};
+    std::deque<Request> m_submitted{};
+    bool m_isStopping{};
+
+    // Set while io_uring is in use.
+    std::unique_ptr<Ring> m_ring{};
+    std::vector<std::thread> m_threads{};
+
+public:
+    explicit FileReader(std::size_t threadCount = 2);
+    // Reads not started yet are dropped without their callbacks, started ones finish.
+    ~FileReader();
+
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
+    void read(fs::path path, Callback callback);
+    void submit();
+
+    [[nodiscard]] bool isUsingIoUring() const noexcept;
+
+private:
+    void runPool();
+    void runRing();
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_FILE_READER_HXX
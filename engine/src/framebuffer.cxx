@@ -0,0 +1,80 @@
+#include "framebuffer.hxx"
+
+#include <glad/glad.h>
+#include <stdexcept>
+#include <string>
+
+#include "opengl_check.hxx"
+#include "render_state.hxx"
+
+using namespace std::literals;
+
+Framebuffer::Framebuffer(std::size_t width, std::size_t height)
+    : m_width{ width }, m_height{ height } {
+    create();
+}
+
+Framebuffer::~Framebuffer() { destroy(); }
+
+void Framebuffer::resize(std::size_t width, std::size_t height) {
+    if (width == m_width && height == m_height) return;
+
+    destroy();
+    m_width = width;
+    m_height = height;
+    create();
+}
+
+void Framebuffer::bind() const { RenderState::getInstance().bindFramebuffer(m_framebuffer); }
+
+const Texture& Framebuffer::getTexture() const noexcept { return m_texture; }
+
+std::size_t Framebuffer::getWidth() const noexcept { return m_width; }
+
+std::size_t Framebuffer::getHeight() const noexcept { return m_height; }
+
+void Framebuffer::create() {
+    if (m_width == 0 || m_height == 0)
+        throw std::runtime_error{ "Error : Framebuffer::create : empty size"s };
+
+    m_texture.load(nullptr, m_width, m_height);
+
+    glGenRenderbuffers(1, &m_depthBuffer);
+    openGLCheck();
+
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    openGLCheck();
+
+    glRenderbufferStorage(GL_RENDERBUFFER,
+                          GL_DEPTH_COMPONENT16,
+                          static_cast<GLsizei>(m_width),
+                          static_cast<GLsizei>(m_height));
+    openGLCheck();
+
+    glGenFramebuffers(1, &m_framebuffer);
+    openGLCheck();
+
+    bind();
+
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, *m_texture, 0);
+    openGLCheck();
+
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+    openGLCheck();
+
+    auto status{ glCheckFramebufferStatus(GL_FRAMEBUFFER) };
+    openGLCheck();
+
+    RenderState::getInstance().bindFramebuffer(0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        throw std::runtime_error{ "Error : Framebuffer::create : incomplete framebuffer: "s +
+                                  std::to_string(status) };
+}
+
+void Framebuffer::destroy() noexcept {
+    // The colour texture is deleted by its Texture, when reloaded or destroyed.
+    RenderState::getInstance().forgetFramebuffer(m_framebuffer);
+    glDeleteFramebuffers(1, &m_framebuffer);
+    glDeleteRenderbuffers(1, &m_depthBuffer);
+}
@@ -0,0 +1,160 @@
+#include "mapped_file.hxx"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(__ANDROID__)
+#    include <SDL3/SDL.h>
+#elif defined(_WIN32)
+#    define WIN32_LEAN_AND_MEAN
+#    define NOMINMAX
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+using namespace std::literals;
+
+#if defined(__ANDROID__)
+
+MappedFile::MappedFile(const fs::path& path) {
+    auto data{ SDL_LoadFile(path.c_str(), &m_size) };
+    if (!data)
+        throw std::runtime_error{ "Error : MappedFile::MappedFile : can't read file: "s +
+                                  path.string() };
+
+    m_data = static_cast<const std::byte*>(data);
+}
+
+void MappedFile::close() noexcept {
+    SDL_free(const_cast<std::byte*>(m_data));
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#elif defined(_WIN32)
+
+MappedFile::MappedFile(const fs::path& path) {
+    m_file = CreateFileW(path.c_str(),
+                         GENERIC_READ,
+                         FILE_SHARE_READ,
+                         nullptr,
+                         OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL,
+                         nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        m_file = nullptr;
+        throw std::runtime_error{ "Error : MappedFile::MappedFile : can't open file: "s +
+                                  path.string() };
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(m_file, &size)) {
+        close();
+        throw std::runtime_error{ "Error : MappedFile::MappedFile : can't get file size: "s +
+                                  path.string() };
+    }
+
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    // Empty files can't be mapped and have nothing to read anyway.
+    if (m_size == 0) return;
+
+    m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    auto data{ m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr };
+    if (!data) {
+        close();
+        throw std::runtime_error{ "Error : MappedFile::MappedFile : can't map file: "s +
+                                  path.string() };
+    }
+
+    m_data = static_cast<const std::byte*>(data);
+}
+
+void MappedFile::close() noexcept {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file) CloseHandle(m_file);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+    m_file = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile(const fs::path& path) {
+    auto descriptor{ ::open(path.c_str(), O_RDONLY) };
+    if (descriptor == -1)
+        throw std::runtime_error{ "Error : MappedFile::MappedFile : can't open file: "s +
+                                  path.string() };
+
+    struct stat status{};
+    if (::fstat(descriptor, &status) == -1) {
+        ::close(descriptor);
+        throw std::runtime_error{ "Error : MappedFile::MappedFile : can't get file size: "s +
+                                  path.string() };
+    }
+
+    m_size = static_cast<std::size_t>(status.st_size);
+    // Empty files can't be mapped and have nothing to read anyway.
+    if (m_size == 0) {
+        ::close(descriptor);
+        return;
+    }
+
+    // The mapping keeps the file alive after its descriptor is closed.
+    auto data{ ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0) };
+    ::close(descriptor);
+
+    if (data == MAP_FAILED) {
+        m_size = 0;
+        throw std::runtime_error{ "Error : MappedFile::MappedFile : can't map file: "s +
+                                  path.string() };
+    }
+
+    m_data = static_cast<const std::byte*>(data);
+}
+
+void MappedFile::close() noexcept {
+    if (m_data) ::munmap(const_cast<std::byte*>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile::MappedFile(MappedFile&& file) noexcept
+    : m_data{ std::exchange(file.m_data, nullptr) }
+    , m_size{ std::exchange(file.m_size, 0) }
+#ifdef _WIN32
+    , m_file{ std::exchange(file.m_file, nullptr) }
+    , m_mapping{ std::exchange(file.m_mapping, nullptr) }
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& file) noexcept {
+    if (this == &file) return *this;
+
+    close();
+    m_data = std::exchange(file.m_data, nullptr);
+    m_size = std::exchange(file.m_size, 0);
+#ifdef _WIN32
+    m_file = std::exchange(file.m_file, nullptr);
+    m_mapping = std::exchange(file.m_mapping, nullptr);
+#endif
+
+    return *this;
+}
+
+std::span<const std::byte> MappedFile::getData() const noexcept { return { m_data, m_size }; }
+
+std::size_t MappedFile::size() const noexcept { return m_size; }
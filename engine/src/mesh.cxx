@@ -0,0 +1,73 @@
+#include "mesh.hxx"
+
+#include <glad/glad.h>
+
+#include "opengl_check.hxx"
+#include "render_state.hxx"
+
+template <typename V, typename T>
+Mesh<V, T>::Mesh(const VertexBuffer<V>& vertexBuffer, const IndexBuffer<T>& indexBuffer)
+    : m_vertexBuffer{ vertexBuffer }, m_indexBuffer{ indexBuffer } {
+    create();
+}
+
+template <typename V, typename T>
+Mesh<V, T>::Mesh(const VertexBuffer<V>& vertexBuffer,
+                 const IndexBuffer<T>& indexBuffer,
+                 const VertexBuffer<Instance2>& instanceBuffer)
+    : m_vertexBuffer{ vertexBuffer }
+    , m_indexBuffer{ indexBuffer }
+    , m_instanceBuffer{ &instanceBuffer } {
+    create();
+}
+
+template <typename V, typename T>
+Mesh<V, T>::~Mesh() {
+    RenderState::getInstance().forgetVertexArray(m_vertexArray);
+    glDeleteVertexArrays(1, &m_vertexArray);
+}
+
+template <typename V, typename T>
+void Mesh<V, T>::create() {
+    glGenVertexArrays(1, &m_vertexArray);
+    openGLCheck();
+
+    auto& renderState{ RenderState::getInstance() };
+    renderState.bindVertexArray(m_vertexArray);
+
+    m_vertexBuffer.bind();
+    renderState.setVertexLayout<V>();
+    auto attributes{ RenderState::getAttributeMask<V>() };
+
+    if (m_instanceBuffer) {
+        m_instanceBuffer->bind();
+        renderState.setVertexLayout<Instance2>();
+        attributes |= RenderState::getAttributeMask<Instance2>();
+    }
+
+    renderState.setEnabledAttributes(attributes);
+    m_indexBuffer.bind();
+}
+
+template <typename V, typename T>
+void Mesh<V, T>::bind() const {
+    RenderState::getInstance().bindVertexArray(m_vertexArray);
+}
+
+template <typename V, typename T>
+std::size_t Mesh<V, T>::getIndexCount() const noexcept {
+    return m_indexBuffer.size();
+}
+
+template <typename V, typename T>
+std::size_t Mesh<V, T>::getInstanceCount() const noexcept {
+    return m_instanceBuffer ? m_instanceBuffer->size() : 1;
+}
+
+template <typename V, typename T>
+bool Mesh<V, T>::isInstanced() const noexcept {
+    return m_instanceBuffer != nullptr;
+}
+
+template class Mesh<Vertex2, std::uint16_t>;
+template class Mesh<Vertex2, std::uint32_t>;
@@ -4,35 +4,136 @@
 
 #include "opengl_check.hxx"
 
+#include <atomic>
+#include <cstdint>
 #include <glad/glad.h>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
 
 using namespace std::literals;
 
-void openGLCheck() {
-    const GLenum err = glGetError();
-    if (err != GL_NO_ERROR) {
-        switch (err) {
-        case GL_INVALID_ENUM:
-            std::cerr << "GL_INVALID_ENUM" << std::endl;
-            break;
-        case GL_INVALID_VALUE:
-            std::cerr << "GL_INVALID_VALUE" << std::endl;
-            break;
-        case GL_INVALID_OPERATION:
-            std::cerr << "GL_INVALID_OPERATION" << std::endl;
-            break;
-        case GL_INVALID_FRAMEBUFFER_OPERATION:
-            std::cerr << "GL_INVALID_FRAMEBUFFER_OPERATION" << std::endl;
-            break;
-        case GL_OUT_OF_MEMORY:
-            std::cerr << "GL_OUT_OF_MEMORY" << std::endl;
-            break;
-        default:
-            std::cerr << "UNKNOWN ERROR" << std::endl;
-            break;
-        }
-        std::cerr << __FILE__ << ':' << __LINE__ << '(' << __FUNCTION__ << ')' << std::endl;
-        throw std::runtime_error{""s};
+static std::atomic<bool> g_isDebugOutputEnabled{};
+
+// The callback may run on a driver thread, so the call site and the last error
+// are shared through atomics and a mutex.
+static std::atomic<const char*> g_lastCheckFile{ "" };
+static std::atomic<const char*> g_lastCheckFunction{ "" };
+static std::atomic<std::uint_least32_t> g_lastCheckLine{};
+
+static std::mutex g_errorMutex{};
+static std::string g_pendingError{};
+static std::atomic<bool> g_hasPendingError{};
+
+static std::string_view severityToStringView(GLenum severity) {
+    switch (severity) {
+    case GL_DEBUG_SEVERITY_HIGH:
+        return "high";
+    case GL_DEBUG_SEVERITY_MEDIUM:
+        return "medium";
+    case GL_DEBUG_SEVERITY_LOW:
+        return "low";
+    default:
+        return "notification";
+    }
+}
+
+static void APIENTRY debugOutputCallback(GLenum source,
+                                         GLenum type,
+                                         GLuint id,
+                                         GLenum severity,
+                                         GLsizei length,
+                                         const GLchar* message,
+                                         const void* userParam) {
+    ( void )source;
+    ( void )userParam;
+
+    std::string text{ message, static_cast<std::size_t>(length) };
+    std::cerr << "GL debug ["sv << severityToStringView(severity) << "] #"sv << id << ": "sv
+              << text << "\n    near "sv << g_lastCheckFile.load() << ':'
+              << g_lastCheckLine.load() << '(' << g_lastCheckFunction.load() << ')' << std::endl;
+
+    if (type != GL_DEBUG_TYPE_ERROR) return;
+
+    std::lock_guard lock{ g_errorMutex };
+    g_pendingError = std::move(text);
+    g_hasPendingError = true;
+}
+
+bool enableOpenGLDebugOutput(OpenGLDebugSeverity minimumSeverity) {
+    if (glDebugMessageCallback == nullptr || glDebugMessageControl == nullptr) return false;
+
+    glEnable(GL_DEBUG_OUTPUT);
+#ifdef ENGINE_GL_CHECKS
+    // The callback then runs inside the failing call, so the last check it reports is near.
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+#endif
+    glDebugMessageCallback(debugOutputCallback, nullptr);
+
+    static constexpr std::pair<OpenGLDebugSeverity, GLenum> severities[]{
+        { OpenGLDebugSeverity::notification, GL_DEBUG_SEVERITY_NOTIFICATION },
+        { OpenGLDebugSeverity::low, GL_DEBUG_SEVERITY_LOW },
+        { OpenGLDebugSeverity::medium, GL_DEBUG_SEVERITY_MEDIUM },
+        { OpenGLDebugSeverity::high, GL_DEBUG_SEVERITY_HIGH }
+    };
+
+    for (auto [severity, glSeverity] : severities)
+        glDebugMessageControl(GL_DONT_CARE,
+                              GL_DONT_CARE,
+                              glSeverity,
+                              0,
+                              nullptr,
+                              severity >= minimumSeverity ? GL_TRUE : GL_FALSE);
+
+    g_isDebugOutputEnabled = glGetError() == GL_NO_ERROR;
+    return g_isDebugOutputEnabled;
+}
+
+#ifdef ENGINE_GL_CHECKS
+static std::string_view errorToStringView(GLenum error) {
+    switch (error) {
+    case GL_INVALID_ENUM:
+        return "GL_INVALID_ENUM";
+    case GL_INVALID_VALUE:
+        return "GL_INVALID_VALUE";
+    case GL_INVALID_OPERATION:
+        return "GL_INVALID_OPERATION";
+    case GL_INVALID_FRAMEBUFFER_OPERATION:
+        return "GL_INVALID_FRAMEBUFFER_OPERATION";
+    case GL_OUT_OF_MEMORY:
+        return "GL_OUT_OF_MEMORY";
+    default:
+        return "UNKNOWN ERROR";
     }
 }
+
+void openGLCheck(const std::source_location& location) {
+    std::string error{};
+
+    if (g_isDebugOutputEnabled) {
+        g_lastCheckFile = location.file_name();
+        g_lastCheckFunction = location.function_name();
+        g_lastCheckLine = location.line();
+
+        if (!g_hasPendingError) return;
+
+        std::lock_guard lock{ g_errorMutex };
+        error = std::move(g_pendingError);
+        g_hasPendingError = false;
+    }
+    else {
+        const GLenum err = glGetError();
+        if (err == GL_NO_ERROR) return;
+
+        error = errorToStringView(err);
+    }
+
+    std::cerr << error << '\n'
+              << location.file_name() << ':' << location.line() << '('
+              << location.function_name() << ')' << std::endl;
+    throw std::runtime_error{ "Error : openGLCheck : "s + error };
+}
+#endif
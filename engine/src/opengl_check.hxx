@@ -5,6 +5,27 @@
 #ifndef VERTEX_MORPHING_OPENGL_CHECK_HXX
 #define VERTEX_MORPHING_OPENGL_CHECK_HXX
 
-void openGLCheck();
+#include <source_location>
+
+enum class OpenGLDebugSeverity
+{
+    notification,
+    low,
+    medium,
+    high
+};
+
+// Routes driver messages of at least minimumSeverity through a GL_DEBUG_OUTPUT
+// callback. Returns false when the context has no debug output, in which case
+// openGLCheck keeps polling glGetError.
+bool enableOpenGLDebugOutput(OpenGLDebugSeverity minimumSeverity);
+
+#ifdef ENGINE_GL_CHECKS
+// With debug output enabled only remembers the call site and rethrows errors
+// reported by the callback, otherwise polls glGetError.
+void openGLCheck(const std::source_location& location = std::source_location::current());
+#else
+inline void openGLCheck() noexcept {}
+#endif
 
 #endif // VERTEX_MORPHING_OPENGL_CHECK_HXX
@@ -0,0 +1,251 @@
+#include "render_queue.hxx"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+void RenderQueue::add(const ShaderProgram& program, const Sprite& sprite) {
+    add({ .program = &program,
+          .texture = &sprite.getTexture(),
+          .viewId = s_noView,
+          .layer = sprite.getLayer(),
+          .blendMode = sprite.getBlendMode(),
+          .matrix = sprite.getResultMatrix() });
+}
+
+void RenderQueue::add(const ShaderProgram& program, const Sprite& sprite, const View& view) {
+    add({ .program = &program,
+          .texture = &sprite.getTexture(),
+          .viewId = getViewId(view),
+          .layer = sprite.getLayer(),
+          .blendMode = sprite.getBlendMode(),
+          .matrix = sprite.getResultMatrix() });
+}
+
+void RenderQueue::add(const ShaderProgram& program,
+                      const Mesh<Vertex2, std::uint16_t>& mesh,
+                      const Texture& texture,
+                      const glm::mat3& matrix,
+                      const View& view,
+                      std::uint8_t layer,
+                      BlendMode blendMode) {
+    if (mesh.getInstanceCount() == 0) return;
+
+    add({ .program = &program,
+          .texture = &texture,
+          .mesh = &mesh,
+          .viewId = getViewId(view),
+          .layer = layer,
+          .blendMode = blendMode,
+          .matrix = matrix });
+}
+
+void RenderQueue::add(const ShaderProgram& program,
+                      const Tilemap& tilemap,
+                      const glm::mat3& matrix,
+                      const View& view,
+                      std::uint8_t layer,
+                      BlendMode blendMode) {
+    add({ .program = &program,
+          .tilemap = &tilemap,
+          .viewId = getViewId(view),
+          .layer = layer,
+          .blendMode = blendMode,
+          .matrix = matrix });
+}
+
+void RenderQueue::add(Item item) {
+    item.key = makeKey(item);
+    m_items.push_back(item);
+}
+
+void RenderQueue::flush(const DrawFunction& draw) {
+    if (m_items.empty()) return;
+
+    sortItems();
+
+    auto isSameRun{ [this](std::uint32_t lhsIndex, std::uint32_t rhsIndex) {
+        const auto& lhs{ m_items[lhsIndex] };
+        const auto& rhs{ m_items[rhsIndex] };
+        return !lhs.mesh && !rhs.mesh && !lhs.tilemap && !rhs.tilemap &&
+               lhs.program == rhs.program &&
+               **lhs.texture == **rhs.texture && lhs.viewId == rhs.viewId &&
+               lhs.layer == rhs.layer && lhs.blendMode == rhs.blendMode;
+    } };
+
+    m_batches.clear();
+    m_vertices.clear();
+
+    for (auto first{ m_order.begin() }; first != m_order.end();) {
+        auto last{ std::find_if_not(std::next(first), m_order.end(), [&](std::uint32_t index) {
+            return isSameRun(*first, index);
+        }) };
+
+        const auto& item{ m_items[*first] };
+
+        Batch batch{ .program = item.program,
+                     .texture = item.texture,
+                     .viewMatrix = item.viewId == s_noView
+                                       ? nullptr
+                                       : &m_viewMatrices.at(item.viewId - 1),
+                     .layer = item.layer,
+                     .blendMode = item.blendMode };
+
+        if (item.mesh) {
+            batch.matrix = &item.matrix;
+            batch.mesh = item.mesh;
+            batch.indexCount = item.mesh->getIndexCount();
+        }
+        else if (item.tilemap) {
+            batch.matrix = &item.matrix;
+            batch.tilemap = item.tilemap;
+            batch.indexCount = Sprite::getUnitQuadIndices().size();
+        }
+        // The unit quad always samples the whole texture, so atlas regions go to the stream.
+        else if (std::next(first) == last && !item.texture->hasRegion()) {
+            batch.matrix = &item.matrix;
+            batch.indexCount = Sprite::getUnitQuadIndices().size();
+        }
+        else {
+            batch.firstIndex = m_vertices.size() / 4 * 6;
+            batch.indexCount = static_cast<std::size_t>(last - first) * 6;
+
+            // Atlas regions of one page share the GL texture and therefore the run.
+            for (auto index{ first }; index != last; ++index) {
+                const auto& entry{ m_items[*index] };
+                const auto& region{ entry.texture->getRegion() };
+
+                for (const auto& vertex : Sprite::getUnitQuadVertices()) {
+                    glm::vec3 position{ entry.matrix * glm::vec3{ vertex.x, vertex.y, 1.0f } };
+                    m_vertices.push_back(vertex);
+                    m_vertices.back().x = position.x;
+                    m_vertices.back().y = position.y;
+                    m_vertices.back().texX = region.xy.x + vertex.texX * region.wh.width;
+                    m_vertices.back().texY = region.xy.y + vertex.texY * region.wh.height;
+                }
+            }
+        }
+
+        m_batches.push_back(batch);
+        first = last;
+    }
+
+    if (!m_vertexBuffer)
+        m_vertexBuffer =
+            std::make_unique<VertexBuffer<Vertex2>>(m_vertices, BufferUsage::stream_draw);
+    else if (!m_vertices.empty())
+        m_vertexBuffer->updateData(m_vertices);
+
+    growIndices(m_vertices.size() / 4);
+
+    if (!m_mesh)
+        m_mesh = std::make_unique<Mesh<Vertex2, std::uint32_t>>(*m_vertexBuffer, *m_indexBuffer);
+
+    for (const auto& batch : m_batches)
+        draw(batch, *m_mesh);
+
+    m_items.clear();
+    m_programs.clear();
+    m_viewMatrices.clear();
+    m_batches.clear();
+}
+
+void RenderQueue::clear() {
+    m_items.clear();
+    m_order.clear();
+    m_sortBuffer.clear();
+    m_programs.clear();
+    m_viewMatrices.clear();
+    m_batches.clear();
+    m_vertices.clear();
+
+    m_mesh.reset();
+    m_vertexBuffer.reset();
+    m_indexBuffer.reset();
+}
+
+bool RenderQueue::empty() const noexcept { return m_items.empty(); }
+
+std::size_t RenderQueue::size() const noexcept { return m_items.size(); }
+
+float RenderQueue::getLayerDepth(std::uint8_t layer) noexcept {
+    // Every layer gets its own depth strictly inside the clip volume.
+    return 1.0f - 2.0f * static_cast<float>(layer + 1) / 257.0f;
+}
+
+std::size_t RenderQueue::getViewId(const View& view) {
+    auto viewMatrix{ view.getViewMatrix() };
+
+    auto found{ std::ranges::find(m_viewMatrices, viewMatrix) };
+    if (found == m_viewMatrices.end()) {
+        m_viewMatrices.push_back(viewMatrix);
+        found = std::prev(m_viewMatrices.end());
+    }
+
+    return static_cast<std::size_t>(found - m_viewMatrices.begin()) + 1;
+}
+
+std::uint64_t RenderQueue::makeKey(const Item& item) {
+    auto program{ std::ranges::find(m_programs, item.program) };
+    if (program == m_programs.end()) {
+        m_programs.push_back(item.program);
+        program = std::prev(m_programs.end());
+    }
+
+    bool isBlended{ item.blendMode == BlendMode::alpha };
+    std::uint64_t depthOrder{ isBlended ? item.layer : 255u - item.layer };
+    // Ids past the field width only lose sorting quality, runs compare the real state.
+    std::uint64_t programId{ std::min<std::uint64_t>(program - m_programs.begin(), 0x7f) };
+    std::uint64_t viewId{ std::min<std::uint64_t>(item.viewId, 0xff) };
+    std::uint64_t textureId{ item.tilemap ? **item.tilemap : **item.texture };
+    bool isWhole{ item.mesh || item.tilemap };
+
+    return static_cast<std::uint64_t>(isBlended) << 63 | depthOrder << 55 | programId << 48 |
+           viewId << 40 | textureId << 8 | static_cast<std::uint64_t>(isWhole) << 7;
+}
+
+void RenderQueue::sortItems() {
+    m_order.resize(m_items.size());
+    m_sortBuffer.resize(m_items.size());
+    std::iota(m_order.begin(), m_order.end(), std::uint32_t{});
+
+    // Least significant digit first; every pass is stable, so is the whole sort.
+    for (std::uint32_t shift{}; shift < 64; shift += 8) {
+        auto digit{ [&](std::uint32_t index) {
+            return static_cast<std::size_t>(m_items[index].key >> shift & 0xff);
+        } };
+
+        std::array<std::size_t, 256> offsets{};
+        for (auto index : m_order)
+            ++offsets[digit(index)];
+
+        // A digit shared by all keys would not change the order.
+        if (offsets[digit(m_order.front())] == m_order.size()) continue;
+
+        std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), std::size_t{});
+
+        for (auto index : m_order)
+            m_sortBuffer[offsets[digit(index)]++] = index;
+
+        m_order.swap(m_sortBuffer);
+    }
+}
+
+void RenderQueue::growIndices(std::size_t spriteCount) {
+    // The index pattern never changes, so only the indices of new sprites are uploaded.
+    if (m_indexBuffer && m_indexBuffer->size() >= spriteCount * 6) return;
+
+    std::vector<std::uint32_t> indices{};
+    for (auto sprite{ static_cast<std::uint32_t>(m_indexBuffer ? m_indexBuffer->size() / 6 : 0) };
+         sprite < spriteCount;
+         ++sprite) {
+        std::uint32_t first{ sprite * 4 };
+        indices.insert(indices.end(),
+                       { first + 0, first + 1, first + 2, first + 0, first + 2, first + 3 });
+    }
+
+    if (!m_indexBuffer)
+        m_indexBuffer = std::make_unique<IndexBuffer<std::uint32_t>>(std::move(indices));
+    else
+        m_indexBuffer->addData(std::move(indices));
+}
@@ -0,0 +1,118 @@
+#ifndef ENGINE_PREPARE_TO_GAME_RENDER_QUEUE_HXX
+#define ENGINE_PREPARE_TO_GAME_RENDER_QUEUE_HXX
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "buffer.hxx"
+#include "mesh.hxx"
+#include "shader_program.hxx"
+#include "sprite.hxx"
+#include "texture.hxx"
+#include "tilemap.hxx"
+#include "view.hxx"
+
+// Collects the sprites, meshes and tilemaps submitted during a frame and draws them on flush
+// in the order of a 64-bit sort key, radix-sorted with submission order kept for
+// equal keys. From the most significant bit down the key holds:
+//   63      blend mode, so every opaque draw precedes every blended one
+//   55..62  layer, inverted for opaque draws: front-to-back opaque, back-to-front blended
+//   48..54  program
+//   40..47  view
+//   8..39   GL texture, the tile id texture for tilemaps
+//   7       submitted mesh or tilemap, so sprites of equal state stay adjacent
+// Sprites of equal state are merged into one run of a CPU-side vertex stream that
+// is uploaded once and drawn with one glDrawElements per run. A run of a single
+// sprite is drawn from the engine's shared unit quad with the sprite matrix instead,
+// unless its texture is an atlas region whose texture coordinates have to be remapped.
+class RenderQueue final
+{
+public:
+    struct Batch
+    {
+        const ShaderProgram* program{};
+        const Texture* texture{};
+        const glm::mat3* viewMatrix{};
+        std::uint8_t layer{};
+        BlendMode blendMode{};
+        // Set when the batch is a single sprite drawn from the unit quad, a mesh or a tilemap.
+        const glm::mat3* matrix{};
+        // Set when the batch is a submitted mesh, drawn whole with all its instances.
+        const Mesh<Vertex2, std::uint16_t>* mesh{};
+        // Set when the batch is a tilemap, drawn as the unit quad stretched over its grid.
+        const Tilemap* tilemap{};
+        std::size_t firstIndex{};
+        std::size_t indexCount{};
+    };
+
+    using DrawFunction =
+        std::function<void(const Batch& batch, const Mesh<Vertex2, std::uint32_t>& mesh)>;
+
+private:
+    struct Item
+    {
+        std::uint64_t key{};
+        const ShaderProgram* program{};
+        const Texture* texture{};
+        const Mesh<Vertex2, std::uint16_t>* mesh{};
+        const Tilemap* tilemap{};
+        std::size_t viewId{};
+        std::uint8_t layer{};
+        BlendMode blendMode{};
+        glm::mat3 matrix{ 1.0f };
+    };
+
+    inline static constexpr std::size_t s_noView{ 0 };
+
+    std::vector<Item> m_items{};
+    std::vector<std::uint32_t> m_order{};
+    std::vector<std::uint32_t> m_sortBuffer{};
+    std::vector<const ShaderProgram*> m_programs{};
+    std::vector<glm::mat3> m_viewMatrices{};
+    std::vector<Batch> m_batches{};
+
+    std::vector<Vertex2> m_vertices{};
+
+    std::unique_ptr<VertexBuffer<Vertex2>> m_vertexBuffer{};
+    std::unique_ptr<IndexBuffer<std::uint32_t>> m_indexBuffer{};
+    std::unique_ptr<Mesh<Vertex2, std::uint32_t>> m_mesh{};
+
+public:
+    void add(const ShaderProgram& program, const Sprite& sprite);
+    void add(const ShaderProgram& program, const Sprite& sprite, const View& view);
+    void add(const ShaderProgram& program,
+             const Mesh<Vertex2, std::uint16_t>& mesh,
+             const Texture& texture,
+             const glm::mat3& matrix,
+             const View& view,
+             std::uint8_t layer,
+             BlendMode blendMode);
+    void add(const ShaderProgram& program,
+             const Tilemap& tilemap,
+             const glm::mat3& matrix,
+             const View& view,
+             std::uint8_t layer,
+             BlendMode blendMode);
+
+    void flush(const DrawFunction& draw);
+    void clear();
+
+    [[nodiscard]] bool empty() const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    // Clip space depth of a layer; higher layers are nearer to the viewer.
+    [[nodiscard]] static float getLayerDepth(std::uint8_t layer) noexcept;
+
+private:
+    void add(Item item);
+    [[nodiscard]] std::size_t getViewId(const View& view);
+    [[nodiscard]] std::uint64_t makeKey(const Item& item);
+    void sortItems();
+    void growIndices(std::size_t spriteCount);
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_RENDER_QUEUE_HXX
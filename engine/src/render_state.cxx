@@ -0,0 +1,223 @@
+#include "render_state.hxx"
+
+#include <glad/glad.h>
+
+#include "opengl_check.hxx"
+
+RenderState& RenderState::getInstance() {
+    static RenderState renderState{};
+
+    return renderState;
+}
+
+void RenderState::useProgram(std::uint32_t program) {
+    if (!update(m_program, program)) return;
+
+    glUseProgram(program);
+    openGLCheck();
+}
+
+void RenderState::bindTexture(std::uint32_t texture, std::uint32_t unit) {
+    activateTextureUnit(unit);
+    if (!update(m_textures.at(unit), texture)) return;
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    openGLCheck();
+}
+
+void RenderState::bindTextureArray(std::uint32_t texture, std::uint32_t unit) {
+    activateTextureUnit(unit);
+    if (!update(m_textureArrays.at(unit), texture)) return;
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    openGLCheck();
+}
+
+void RenderState::bindArrayBuffer(std::uint32_t buffer) {
+    if (!update(m_arrayBuffer, buffer)) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    openGLCheck();
+}
+
+void RenderState::bindElementArrayBuffer(std::uint32_t buffer) {
+    if (!update(getVertexArrayState().elementArrayBuffer, buffer)) return;
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+    openGLCheck();
+}
+
+void RenderState::bindVertexArray(std::uint32_t vertexArray) {
+    if (!update(m_vertexArray, vertexArray)) return;
+
+    glBindVertexArray(vertexArray);
+    openGLCheck();
+
+    if (vertexArray != m_defaultVertexArray) m_meshVertexArrayState = {};
+}
+
+void RenderState::bindFramebuffer(std::uint32_t framebuffer) {
+    if (!update(m_framebuffer, framebuffer)) return;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    openGLCheck();
+}
+
+void RenderState::setBlending(bool isEnabled) {
+    if (!update(m_blending, isEnabled)) return;
+
+    if (isEnabled)
+        glEnable(GL_BLEND);
+    else
+        glDisable(GL_BLEND);
+    openGLCheck();
+}
+
+void RenderState::setDepthWrite(bool isEnabled) {
+    if (!update(m_depthWrite, isEnabled)) return;
+
+    glDepthMask(isEnabled ? GL_TRUE : GL_FALSE);
+    openGLCheck();
+}
+
+void RenderState::setDefaultVertexArray(std::uint32_t vertexArray) noexcept {
+    m_defaultVertexArray = vertexArray;
+    m_defaultVertexArrayState = {};
+}
+
+void RenderState::bindDefaultVertexArray() { bindVertexArray(m_defaultVertexArray); }
+
+void RenderState::setEnabledAttributes(std::bitset<s_maxAttributes> attributes) {
+    auto& state{ getVertexArrayState() };
+
+    for (std::uint32_t index{}; index < s_maxAttributes; ++index) {
+        if (state.areEnabledAttributesKnown &&
+            state.enabledAttributes[index] == attributes[index]) {
+            ++m_counters.elided;
+            continue;
+        }
+
+        ++m_counters.issued;
+        if (attributes[index])
+            glEnableVertexAttribArray(index);
+        else
+            glDisableVertexAttribArray(index);
+        openGLCheck();
+    }
+
+    state.enabledAttributes = attributes;
+    state.areEnabledAttributesKnown = true;
+}
+
+void RenderState::setAttributeLayout(std::uint32_t index, const AttributeLayout& layout) {
+    auto& attribute{ getVertexArrayState().attributes.at(index) };
+
+    if (attribute.isKnown && attribute.buffer == m_arrayBuffer &&
+        attribute.layout.size == layout.size && attribute.layout.type == layout.type &&
+        attribute.layout.normalized == layout.normalized &&
+        attribute.layout.stride == layout.stride && attribute.layout.offset == layout.offset)
+        ++m_counters.elided;
+    else {
+        ++m_counters.issued;
+        glVertexAttribPointer(index,
+                              layout.size,
+                              layout.type,
+                              layout.normalized ? GL_TRUE : GL_FALSE,
+                              layout.stride,
+                              reinterpret_cast<const GLvoid*>(layout.offset));
+        openGLCheck();
+    }
+
+    if (attribute.isKnown && attribute.layout.divisor == layout.divisor)
+        ++m_counters.elided;
+    else {
+        ++m_counters.issued;
+        glVertexAttribDivisor(index, layout.divisor);
+        openGLCheck();
+    }
+
+    attribute = { .buffer = m_arrayBuffer, .layout = layout, .isKnown = true };
+}
+
+void RenderState::forgetProgram(std::uint32_t program) noexcept {
+    if (m_program == program) m_program = s_unknown;
+}
+
+void RenderState::forgetTexture(std::uint32_t texture) noexcept {
+    for (auto* textures : { &m_textures, &m_textureArrays })
+        for (auto& bound : *textures)
+            if (bound == texture) bound = s_unknown;
+}
+
+void RenderState::forgetBuffer(std::uint32_t buffer) noexcept {
+    if (m_arrayBuffer == buffer) m_arrayBuffer = s_unknown;
+
+    for (auto* state : { &m_defaultVertexArrayState, &m_meshVertexArrayState }) {
+        if (state->elementArrayBuffer == buffer) state->elementArrayBuffer = s_unknown;
+
+        for (auto& attribute : state->attributes)
+            if (attribute.buffer == buffer) attribute.isKnown = false;
+    }
+}
+
+void RenderState::forgetVertexArray(std::uint32_t vertexArray) noexcept {
+    if (vertexArray == m_defaultVertexArray) m_defaultVertexArrayState = {};
+    if (vertexArray == m_vertexArray) m_vertexArray = s_unknown;
+}
+
+void RenderState::forgetFramebuffer(std::uint32_t framebuffer) noexcept {
+    if (m_framebuffer == framebuffer) m_framebuffer = s_unknown;
+}
+
+void RenderState::invalidate() noexcept {
+    m_program = s_unknown;
+    m_activeTextureUnit = s_unknown;
+    m_textures.fill(s_unknown);
+    m_textureArrays.fill(s_unknown);
+    m_arrayBuffer = s_unknown;
+    m_vertexArray = s_unknown;
+    m_framebuffer = s_unknown;
+    m_blending = s_unknown;
+    m_depthWrite = s_unknown;
+    m_defaultVertexArrayState = {};
+    m_meshVertexArrayState = {};
+}
+
+const RenderState::Counters& RenderState::getCounters() const noexcept { return m_counters; }
+
+void RenderState::resetCounters() noexcept { m_counters = {}; }
+
+void RenderState::activateTextureUnit(std::uint32_t unit) {
+    if (!update(m_activeTextureUnit, unit)) return;
+
+    glActiveTexture(GL_TEXTURE0 + unit);
+    openGLCheck();
+}
+
+bool RenderState::update(std::uint32_t& cached, std::uint32_t value) noexcept {
+    if (cached == value) {
+        ++m_counters.elided;
+        return false;
+    }
+
+    ++m_counters.issued;
+    cached = value;
+    return true;
+}
+
+RenderState::VertexArrayState& RenderState::getVertexArrayState() noexcept {
+    return m_vertexArray == m_defaultVertexArray ? m_defaultVertexArrayState
+                                                 : m_meshVertexArrayState;
+}
+
+std::uint32_t RenderState::toGLType(VertexAttribute::Type type) noexcept {
+    switch (type) {
+    case VertexAttribute::Type::uint8:
+        return GL_UNSIGNED_BYTE;
+    case VertexAttribute::Type::uint16:
+        return GL_UNSIGNED_SHORT;
+    case VertexAttribute::Type::float32:
+    default:
+        return GL_FLOAT;
+    }
+}
@@ -0,0 +1,138 @@
+#ifndef ENGINE_PREPARE_TO_GAME_RENDER_STATE_HXX
+#define ENGINE_PREPARE_TO_GAME_RENDER_STATE_HXX
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+#include "buffer.hxx"
+
+// Shadow copy of the GL state the engine touches. Every bind goes through it and
+// is only forwarded to GL when the value actually changes. The cache has to be
+// invalidated whenever someone else (e.g. ImGui) changes the state behind its back.
+class RenderState final
+{
+public:
+    inline static constexpr std::size_t s_maxAttributes{ 8 };
+
+    struct Counters
+    {
+        std::size_t issued{};
+        std::size_t elided{};
+    };
+
+    struct AttributeLayout
+    {
+        std::int32_t size{};
+        std::uint32_t type{};
+        bool normalized{};
+        std::int32_t stride{};
+        std::size_t offset{};
+        std::uint32_t divisor{};
+    };
+
+private:
+    inline static constexpr std::uint32_t s_unknown{ 0xffffffff };
+
+    struct Attribute
+    {
+        std::uint32_t buffer{};
+        AttributeLayout layout{};
+        bool isKnown{};
+    };
+
+    // State stored in a vertex array object.
+    struct VertexArrayState
+    {
+        std::uint32_t elementArrayBuffer{ s_unknown };
+        std::bitset<s_maxAttributes> enabledAttributes{};
+        bool areEnabledAttributesKnown{};
+        std::array<Attribute, s_maxAttributes> attributes{};
+    };
+
+    std::uint32_t m_program{ s_unknown };
+    std::uint32_t m_activeTextureUnit{ s_unknown };
+    std::array<std::uint32_t, 4> m_textures{ s_unknown, s_unknown, s_unknown, s_unknown };
+    std::array<std::uint32_t, 4> m_textureArrays{ s_unknown, s_unknown, s_unknown, s_unknown };
+    std::uint32_t m_arrayBuffer{ s_unknown };
+    std::uint32_t m_vertexArray{ s_unknown };
+    std::uint32_t m_framebuffer{ s_unknown };
+    std::uint32_t m_blending{ s_unknown };
+    std::uint32_t m_depthWrite{ s_unknown };
+
+    // Immediate draws share the default vertex array and keep its state across
+    // mesh draws; a mesh array is configured once, so only the bound one is tracked.
+    std::uint32_t m_defaultVertexArray{};
+    VertexArrayState m_defaultVertexArrayState{};
+    VertexArrayState m_meshVertexArrayState{};
+
+    Counters m_counters{};
+
+public:
+    static RenderState& getInstance();
+
+    void useProgram(std::uint32_t program);
+    void bindTexture(std::uint32_t texture, std::uint32_t unit = 0);
+    void bindTextureArray(std::uint32_t texture, std::uint32_t unit = 0);
+    void bindArrayBuffer(std::uint32_t buffer);
+    void bindElementArrayBuffer(std::uint32_t buffer);
+    void bindVertexArray(std::uint32_t vertexArray);
+    void bindFramebuffer(std::uint32_t framebuffer);
+
+    void setBlending(bool isEnabled);
+    void setDepthWrite(bool isEnabled);
+
+    void setDefaultVertexArray(std::uint32_t vertexArray) noexcept;
+    void bindDefaultVertexArray();
+
+    // Leaves exactly the attributes of the mask enabled.
+    void setEnabledAttributes(std::bitset<s_maxAttributes> attributes);
+    // Describes an attribute fed from the currently bound array buffer.
+    void setAttributeLayout(std::uint32_t index, const AttributeLayout& layout);
+    // Describes all attributes of V fed from the currently bound array buffer.
+    template <typename V>
+    void setVertexLayout();
+
+    // Deleted names may be reused by GL, so they must not stay in the cache.
+    void forgetProgram(std::uint32_t program) noexcept;
+    void forgetTexture(std::uint32_t texture) noexcept;
+    void forgetBuffer(std::uint32_t buffer) noexcept;
+    void forgetVertexArray(std::uint32_t vertexArray) noexcept;
+    void forgetFramebuffer(std::uint32_t framebuffer) noexcept;
+
+    void invalidate() noexcept;
+
+    [[nodiscard]] const Counters& getCounters() const noexcept;
+    void resetCounters() noexcept;
+
+    template <typename V>
+    [[nodiscard]] static std::bitset<s_maxAttributes> getAttributeMask() noexcept {
+        std::bitset<s_maxAttributes> mask{};
+        for (const auto& attribute : VertexLayout<V>::attributes)
+            mask.set(attribute.index);
+        return mask;
+    }
+
+private:
+    RenderState() = default;
+
+    [[nodiscard]] VertexArrayState& getVertexArrayState() noexcept;
+    [[nodiscard]] static std::uint32_t toGLType(VertexAttribute::Type type) noexcept;
+    void activateTextureUnit(std::uint32_t unit);
+    [[nodiscard]] bool update(std::uint32_t& cached, std::uint32_t value) noexcept;
+};
+
+template <typename V>
+void RenderState::setVertexLayout() {
+    for (const auto& attribute : VertexLayout<V>::attributes)
+        setAttributeLayout(attribute.index,
+                           { .size = attribute.size,
+                             .type = toGLType(attribute.type),
+                             .normalized = attribute.normalized,
+                             .stride = static_cast<std::int32_t>(sizeof(V)),
+                             .offset = attribute.offset,
+                             .divisor = VertexLayout<V>::divisor });
+}
+
+#endif // ENGINE_PREPARE_TO_GAME_RENDER_STATE_HXX
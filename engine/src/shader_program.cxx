@@ -7,9 +7,19 @@
 #include <vector>
 
 #include "opengl_check.hxx"
+#include "render_state.hxx"
 
 using namespace std::literals;
 
+template <typename T>
+static constexpr GLenum s_uniformType{};
+template <>
+constexpr GLenum s_uniformType<float>{ GL_FLOAT };
+template <>
+constexpr GLenum s_uniformType<glm::vec2>{ GL_FLOAT_VEC2 };
+template <>
+constexpr GLenum s_uniformType<glm::mat3>{ GL_FLOAT_MAT3 };
+
 #ifndef __ANDROID__
 static std::string readFile(const fs::path& path) {
     std::ifstream in{ path };
@@ -58,8 +68,11 @@ ShaderProgram::ShaderProgram(const fs::path& vertPath, const fs::path& fragPath)
 }
 
 void ShaderProgram::recompileShaders(const fs::path& vertPath, const fs::path& fragPath) {
-    if(m_program) glDeleteProgram(m_program);
-    openGLCheck();
+    if (m_program) {
+        RenderState::getInstance().forgetProgram(m_program);
+        glDeleteProgram(m_program);
+        openGLCheck();
+    }
 
     m_program = glCreateProgram();
     openGLCheck();
@@ -105,6 +118,66 @@ void ShaderProgram::recompileShaders(const fs::path& vertPath, const fs::path& f
 
     glDeleteShader(fragmentShader);
     openGLCheck();
+
+    reflectUniforms();
+}
+
+void ShaderProgram::reflectUniforms() {
+    m_uniforms.clear();
+
+    GLint uniformCount{};
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    openGLCheck();
+
+    GLint maxNameLength{};
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    openGLCheck();
+
+    std::vector<char> nameChars(static_cast<std::size_t>(maxNameLength) + 1);
+    std::uint32_t nextUnit{};
+
+    // Sampler units never change after linking, so they are assigned once here.
+    use();
+
+    for (GLuint index{}; index < static_cast<GLuint>(uniformCount); ++index) {
+        GLsizei nameLength{};
+        GLint size{};
+        GLenum type{};
+        glGetActiveUniform(m_program,
+                           index,
+                           static_cast<GLsizei>(nameChars.size()),
+                           &nameLength,
+                           &size,
+                           &type,
+                           nameChars.data());
+        openGLCheck();
+
+        std::string name{ nameChars.data(), static_cast<std::size_t>(nameLength) };
+        if (name.ends_with("[0]")) name.resize(name.size() - 3);
+
+        auto location{ glGetUniformLocation(m_program, name.c_str()) };
+        openGLCheck();
+
+        // Members of uniform blocks have no location.
+        if (location == -1) continue;
+
+        Uniform uniform{ .location = location, .type = type };
+        if (type == GL_SAMPLER_2D || type == GL_SAMPLER_2D_ARRAY) {
+            uniform.unit = nextUnit++;
+            glUniform1i(location, static_cast<GLint>(uniform.unit));
+            openGLCheck();
+        }
+
+        m_uniforms.emplace(std::move(name), uniform);
+    }
+
+    auto cameraBlock{ glGetUniformBlockIndex(m_program, "Camera") };
+    openGLCheck();
+
+    if (cameraBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(m_program, cameraBlock, s_cameraBlockBinding);
+        openGLCheck();
+    }
 }
 
 GLuint ShaderProgram::compileShader(GLenum type, const fs::path& path) {
@@ -141,48 +214,78 @@ GLuint ShaderProgram::compileShader(GLenum type, const fs::path& path) {
 
     return shader;
 }
-void ShaderProgram::use() const {
-    glUseProgram(m_program);
-    openGLCheck();
-}
+void ShaderProgram::use() const { RenderState::getInstance().useProgram(m_program); }
 
 GLuint ShaderProgram::operator*() const noexcept { return m_program; }
 
 ShaderProgram::~ShaderProgram() {
-    if (m_program) glDeleteProgram(m_program);
+    if (m_program) {
+        RenderState::getInstance().forgetProgram(m_program);
+        glDeleteProgram(m_program);
+    }
 }
 
-void ShaderProgram::setUniform(std::string_view name, float value) const {
-    auto location{ glGetUniformLocation(m_program, name.data()) };
-    openGLCheck();
+template <typename T>
+UniformHandle<T> ShaderProgram::getUniform(std::string_view name) const {
+    auto found{ m_uniforms.find(name) };
+    // Like glGetUniformLocation, unknown names give a location that GL ignores.
+    if (found == m_uniforms.end()) return {};
 
-    glUniform1f(location, value);
-    openGLCheck();
+    if (found->second.type != s_uniformType<T>)
+        throw std::runtime_error{ "Error : ShaderProgram::getUniform : type mismatch of "s +
+                                  std::string{ name } };
+
+    return { .location = found->second.location };
 }
 
-void ShaderProgram::setUniform(std::string_view name, const Texture& texture) const {
-    auto location{ glGetUniformLocation(m_program, name.data()) };
-    openGLCheck();
+template UniformHandle<float> ShaderProgram::getUniform(std::string_view name) const;
+template UniformHandle<glm::vec2> ShaderProgram::getUniform(std::string_view name) const;
+template UniformHandle<glm::mat3> ShaderProgram::getUniform(std::string_view name) const;
 
-    glUniform1i(location, 0);
-    openGLCheck();
+bool ShaderProgram::hasUniform(std::string_view name) const { return m_uniforms.contains(name); }
+
+std::uint32_t ShaderProgram::getSamplerUnit(std::string_view name) const {
+    auto found{ m_uniforms.find(name) };
+    return found == m_uniforms.end() ? 0 : found->second.unit;
+}
 
-    glActiveTexture(GL_TEXTURE0);
+void ShaderProgram::setUniform(UniformHandle<float> uniform, float value) const {
+    glUniform1f(uniform.location, value);
     openGLCheck();
 }
 
-void ShaderProgram::setUniform(std::string_view name, const glm::mat3& matrix) const {
-    auto location{ glGetUniformLocation(m_program, name.data()) };
+void ShaderProgram::setUniform(UniformHandle<glm::vec2> uniform, const glm::vec2& value) const {
+    glUniform2fv(uniform.location, 1, glm::value_ptr(value));
     openGLCheck();
+}
 
-    glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+void ShaderProgram::setUniform(UniformHandle<glm::mat3> uniform, const glm::mat3& matrix) const {
+    glUniformMatrix3fv(uniform.location, 1, GL_FALSE, glm::value_ptr(matrix));
     openGLCheck();
 }
 
+void ShaderProgram::setUniform(std::string_view name, float value) const {
+    setUniform(getUniform<float>(name), value);
+}
+
+void ShaderProgram::setUniform(std::string_view name, const glm::vec2& value) const {
+    setUniform(getUniform<glm::vec2>(name), value);
+}
+
+void ShaderProgram::setUniform(std::string_view name, const Texture& texture) const {
+    RenderState::getInstance().bindTexture(*texture, getSamplerUnit(name));
+}
+
+void ShaderProgram::setUniform(std::string_view name, const glm::mat3& matrix) const {
+    setUniform(getUniform<glm::mat3>(name), matrix);
+}
+
 void ShaderProgram::setGLSLVersion(const std::string& version) { s_glslVersion = version; }
 
 void ShaderProgram::clear() {
+    RenderState::getInstance().forgetProgram(m_program);
     glDeleteProgram(m_program);
     openGLCheck();
     m_program = 0;
+    m_uniforms.clear();
 }
@@ -0,0 +1,184 @@
+#include "spatial_hash.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals;
+
+SpatialHash::SpatialHash(float cellSize) : m_cellSize{ cellSize } {
+    if (!(m_cellSize > 0.0f))
+        throw std::runtime_error{
+            "Error : SpatialHash::SpatialHash : cell size must be positive"s
+        };
+}
+
+SpatialHash::Handle SpatialHash::insert(const Rectangle& bounds, std::uint64_t userData) {
+    Handle handle{};
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else {
+        handle = static_cast<Handle>(m_objects.size());
+        m_objects.emplace_back();
+    }
+
+    auto& object{ m_objects[handle] };
+    object = { .bounds = bounds, .userData = userData, .isAlive = true };
+    setCells(object, bounds);
+    link(handle);
+
+    ++m_size;
+    return handle;
+}
+
+void SpatialHash::move(Handle handle, const Rectangle& bounds) {
+    auto& object{ getObject(handle) };
+    object.bounds = bounds;
+
+    // Moves within the same cells only change the bounds.
+    Object moved{ object };
+    setCells(moved, bounds);
+    if (moved.firstColumn == object.firstColumn && moved.firstRow == object.firstRow &&
+        moved.lastColumn == object.lastColumn && moved.lastRow == object.lastRow)
+        return;
+
+    unlink(handle);
+    setCells(object, bounds);
+    link(handle);
+}
+
+void SpatialHash::remove(Handle handle) {
+    auto& object{ getObject(handle) };
+
+    unlink(handle);
+    object.isAlive = false;
+    m_freeHandles.push_back(handle);
+    --m_size;
+}
+
+void SpatialHash::clear() {
+    m_objects.clear();
+    m_freeHandles.clear();
+    m_cells.clear();
+    m_size = 0;
+}
+
+void SpatialHash::setUserData(Handle handle, std::uint64_t userData) {
+    getObject(handle).userData = userData;
+}
+
+std::uint64_t SpatialHash::getUserData(Handle handle) const { return getObject(handle).userData; }
+
+const Rectangle& SpatialHash::getBounds(Handle handle) const { return getObject(handle).bounds; }
+
+void SpatialHash::query(const Rectangle& area, std::vector<Handle>& result) const {
+    Object range{};
+    setCells(range, area);
+
+    // Objects spanning several cells are met once per cell.
+    if (++m_queryStamp == 0) {
+        for (const auto& object : m_objects)
+            object.queryStamp = 0;
+        m_queryStamp = 1;
+    }
+
+    for (auto row{ range.firstRow }; row <= range.lastRow; ++row)
+        for (auto column{ range.firstColumn }; column <= range.lastColumn; ++column) {
+            auto cell{ m_cells.find(getCellKey(column, row)) };
+            if (cell == m_cells.end()) continue;
+
+            for (auto handle : cell->second) {
+                const auto& object{ m_objects[handle] };
+                if (object.queryStamp == m_queryStamp) continue;
+
+                object.queryStamp = m_queryStamp;
+                if (intersect(object.bounds, area)) result.push_back(handle);
+            }
+        }
+}
+
+void SpatialHash::findPairs(std::vector<std::pair<Handle, Handle>>& pairs) const {
+    for (const auto& [key, handles] : m_cells) {
+        auto column{ static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32)) };
+        auto row{ static_cast<std::int32_t>(static_cast<std::uint32_t>(key)) };
+
+        for (std::size_t i{}; i < handles.size(); ++i)
+            for (auto j{ i + 1 }; j < handles.size(); ++j) {
+                const auto& first{ m_objects[handles[i]] };
+                const auto& second{ m_objects[handles[j]] };
+
+                // Objects sharing several cells are paired in the first one only.
+                if (std::max(first.firstColumn, second.firstColumn) != column ||
+                    std::max(first.firstRow, second.firstRow) != row)
+                    continue;
+
+                if (!intersect(first.bounds, second.bounds)) continue;
+
+                pairs.emplace_back(std::min(handles[i], handles[j]),
+                                   std::max(handles[i], handles[j]));
+            }
+    }
+}
+
+std::size_t SpatialHash::size() const noexcept { return m_size; }
+
+SpatialHash::Object& SpatialHash::getObject(Handle handle) {
+    if (handle >= m_objects.size() || !m_objects[handle].isAlive)
+        throw std::runtime_error{ "Error : SpatialHash::getObject : invalid handle"s };
+
+    return m_objects[handle];
+}
+
+const SpatialHash::Object& SpatialHash::getObject(Handle handle) const {
+    if (handle >= m_objects.size() || !m_objects[handle].isAlive)
+        throw std::runtime_error{ "Error : SpatialHash::getObject : invalid handle"s };
+
+    return m_objects[handle];
+}
+
+void SpatialHash::setCells(Object& object, const Rectangle& bounds) const noexcept {
+    auto toCell{ [this](float x) {
+        return static_cast<std::int32_t>(std::floor(x / m_cellSize));
+    } };
+
+    object.firstColumn = toCell(bounds.xy.x);
+    object.firstRow = toCell(bounds.xy.y);
+    object.lastColumn = std::max(object.firstColumn, toCell(bounds.xy.x + bounds.wh.width));
+    object.lastRow = std::max(object.firstRow, toCell(bounds.xy.y + bounds.wh.height));
+}
+
+void SpatialHash::link(Handle handle) {
+    const auto& object{ m_objects[handle] };
+
+    for (auto row{ object.firstRow }; row <= object.lastRow; ++row)
+        for (auto column{ object.firstColumn }; column <= object.lastColumn; ++column)
+            m_cells[getCellKey(column, row)].push_back(handle);
+}
+
+void SpatialHash::unlink(Handle handle) {
+    const auto& object{ m_objects[handle] };
+
+    for (auto row{ object.firstRow }; row <= object.lastRow; ++row)
+        for (auto column{ object.firstColumn }; column <= object.lastColumn; ++column) {
+            auto cell{ m_cells.find(getCellKey(column, row)) };
+            if (cell == m_cells.end()) continue;
+
+            // Order within a cell does not matter, so removal is a swap with the last.
+            auto& handles{ cell->second };
+            auto found{ std::ranges::find(handles, handle) };
+            if (found != handles.end()) {
+                *found = handles.back();
+                handles.pop_back();
+            }
+
+            if (handles.empty()) m_cells.erase(cell);
+        }
+}
+
+std::uint64_t SpatialHash::getCellKey(std::int32_t column, std::int32_t row) noexcept {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(column)) << 32 |
+           static_cast<std::uint32_t>(row);
+}
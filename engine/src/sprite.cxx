@@ -1,5 +1,6 @@
 #include "sprite.hxx"
 
+#include "asset_registry.hxx"
 #include "engine.hxx"
 
 Sprite::Sprite(Size size)
@@ -10,11 +11,10 @@ Sprite::Sprite(Size size)
 }
 
 Sprite::Sprite(const fs::path& texturePath)
-    : m_hasTexture{ true }
-    , m_texture{ new Texture{} }
+    : m_ownTexture{ AssetRegistry::getInstance().getTexture(texturePath) }
+    , m_texture{ m_ownTexture.get() }
     , m_windowWidth{ getEngineInstance()->getWindowSize().width }
     , m_windowHeight{ getEngineInstance()->getWindowSize().height } {
-    m_texture->load(texturePath);
     m_size.width = m_texture->getWidth();
     m_size.height = m_texture->getHeight();
     initialize();
@@ -22,11 +22,10 @@ Sprite::Sprite(const fs::path& texturePath)
 
 Sprite::Sprite(const fs::path& texturePath, Size size)
     : m_size{ size }
-    , m_hasTexture{ true }
-    , m_texture{ new Texture{} }
+    , m_ownTexture{ AssetRegistry::getInstance().getTexture(texturePath) }
+    , m_texture{ m_ownTexture.get() }
     , m_windowWidth{ getEngineInstance()->getWindowSize().width }
     , m_windowHeight{ getEngineInstance()->getWindowSize().height } {
-    m_texture->load(texturePath);
     initialize();
 }
 
@@ -36,6 +35,14 @@ void Sprite::checkAspect(Size size) {
 }
 
 glm::mat3 Sprite::getResultMatrix() const noexcept {
+    glm::mat3 sizeMatrix{ 1.0f };
+    sizeMatrix[0][0] = m_size.width / (s_originalWindowSize.width / 2.0f);
+    sizeMatrix[1][1] = m_size.height / (s_originalWindowSize.height / 2.0f);
+
+    return getTransformMatrix() * sizeMatrix;
+}
+
+glm::mat3 Sprite::getTransformMatrix() const noexcept {
     auto mat{ m_scaleMatrix };
     mat[1][1] *= m_aspectMatrix[1][1];
     mat[0][0] *= m_aspectMatrix[0][0];
@@ -92,11 +99,15 @@ void Sprite::setRotate(float angle) {
 
 Angle Sprite::getRotate() const noexcept { return m_rotationAngle; }
 
-const std::vector<Vertex2>& Sprite::getVertices() const noexcept { return m_vertices; }
+const Texture& Sprite::getTexture() const noexcept { return *m_texture; }
 
-const std::vector<uint16_t>& Sprite::getIndices() const noexcept { return m_indices; }
+void Sprite::setLayer(std::uint8_t layer) noexcept { m_layer = layer; }
 
-const Texture& Sprite::getTexture() const noexcept { return *m_texture; }
+std::uint8_t Sprite::getLayer() const noexcept { return m_layer; }
+
+void Sprite::setBlendMode(BlendMode blendMode) noexcept { m_blendMode = blendMode; }
+
+BlendMode Sprite::getBlendMode() const noexcept { return m_blendMode; }
 
 void Sprite::updateWindowSize() {
     m_windowWidth = getEngineInstance()->getWindowSize().width;
@@ -109,10 +120,6 @@ Rectangle Sprite::getRectangle() const noexcept {
                       .wh = { getSize() } };
 }
 
-Sprite::~Sprite() {
-    if (m_hasTexture) delete m_texture;
-}
-
 void Sprite::initialize() {
     m_moveMatrix[0][0] = 1.0f;
     m_moveMatrix[1][1] = 1.0f;
@@ -134,41 +141,28 @@ void Sprite::initialize() {
         s_originalWindowSize.width = getEngineInstance()->getWindowSize().width;
         s_originalWindowSize.height = getEngineInstance()->getWindowSize().height;
     }
-
-    m_vertices.push_back({ (-m_size.width / 2) / (s_originalWindowSize.width / 2.0f),
-                           (m_size.height / 2) / (s_originalWindowSize.height / 2.0f),
-                           0.0,
-                           0.0,
-                           0 });
-
-    m_vertices.push_back({ (m_size.width / 2) / (s_originalWindowSize.width / 2.0f),
-                           (m_size.height / 2) / (s_originalWindowSize.height / 2.0f),
-                           1.0,
-                           0.0,
-                           0 });
-
-    m_vertices.push_back({ (m_size.width / 2) / (s_originalWindowSize.width / 2.0f),
-                           (-m_size.height / 2) / (s_originalWindowSize.height / 2.0f),
-                           1.0,
-                           1.0,
-                           0 });
-
-    m_vertices.push_back({ (-m_size.width / 2) / (s_originalWindowSize.width / 2.0f),
-                           (-m_size.height / 2) / (s_originalWindowSize.height / 2.0f),
-                           0.0,
-                           1.0,
-                           0 });
-
-    m_indices = { 0, 1, 2, 0, 2, 3 };
 }
 
 void Sprite::setTexture(Texture& texture) {
-    if (m_hasTexture) throw std::runtime_error{ "Error : setTexture : The sprite has own texture" };
+    if (m_ownTexture) throw std::runtime_error{ "Error : setTexture : The sprite has own texture" };
     m_texture = &texture;
 }
 
 void Sprite::setOriginalSize(Size size) { s_originalWindowSize = size; }
 
+const std::array<Vertex2, 4>& Sprite::getUnitQuadVertices() noexcept {
+    static constexpr std::array<Vertex2, 4> vertices{ Vertex2{ -0.5f, 0.5f, 0.0f, 0.0f, 0 },
+                                                      Vertex2{ 0.5f, 0.5f, 1.0f, 0.0f, 0 },
+                                                      Vertex2{ 0.5f, -0.5f, 1.0f, 1.0f, 0 },
+                                                      Vertex2{ -0.5f, -0.5f, 0.0f, 1.0f, 0 } };
+    return vertices;
+}
+
+const std::array<std::uint16_t, 6>& Sprite::getUnitQuadIndices() noexcept {
+    static constexpr std::array<std::uint16_t, 6> indices{ 0, 1, 2, 0, 2, 3 };
+    return indices;
+}
+
 std::optional<Rectangle> intersect(const Sprite& s1, const Sprite& s2) {
     return intersect(s1.getRectangle(), s2.getRectangle());
 }
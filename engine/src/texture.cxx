@@ -1,40 +1,222 @@
 #include "texture.hxx"
 
+#include <cstring>
 #include <glad/glad.h>
-
+#include <istream>
+#include <optional>
+#include <streambuf>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "cooked_texture.hxx"
+#include "mapped_file.hxx"
 #include "opengl_check.hxx"
+#include "render_state.hxx"
 
 #ifndef __ANDROID__
 #    include <boost/gil/extension/io/png.hpp>
 namespace gil = boost::gil;
+#else
+#    include <SDL3/SDL.h>
 #endif
 
-Texture::~Texture() {
-    if (m_copied) glDeleteTextures(1, &m_texture);
+Texture::~Texture() { release(); }
+
+// Blending expects colours premultiplied by their alpha.
+static void premultiply(std::vector<std::uint8_t>& pixels) noexcept {
+    for (std::size_t i{}; i + 3 < pixels.size(); i += 4) {
+        unsigned alpha{ pixels[i + 3] };
+        for (std::size_t c{}; c < 3; ++c)
+            pixels[i + c] = static_cast<std::uint8_t>((pixels[i + c] * alpha + 127) / 255);
+    }
 }
 
 #ifndef __ANDROID__
+// Read-only stream over memory, so gil decodes without a copy of the file.
+class MemoryBuffer final : public std::streambuf
+{
+public:
+    explicit MemoryBuffer(std::span<const std::byte> data) {
+        auto first{ const_cast<char*>(reinterpret_cast<const char*>(data.data())) };
+        setg(first, first, first + data.size());
+    }
+};
 
-void Texture::load(const fs::path& path) {
+static PixelData toPixelData(const gil::rgba8_image_t& image) {
+    auto first{ gil::interleaved_view_get_raw_data(gil::const_view(image)) };
+    auto size{ static_cast<std::size_t>(image.width() * image.height()) * 4 };
+
+    return { .pixels = { first, first + size },
+             .width = static_cast<std::size_t>(image.width()),
+             .height = static_cast<std::size_t>(image.height()) };
+}
+
+static PixelData decodePng(const fs::path& path) {
     gil::rgba8_image_t image{};
     gil::read_and_convert_image(path, image, gil::png_tag{});
+    return toPixelData(image);
+}
+
+static PixelData decodePng(std::span<const std::byte> file) {
+    MemoryBuffer buffer{ file };
+    std::istream in{ &buffer };
 
-    load(gil::interleaved_view_get_raw_data(gil::view(image)), image.width(), image.height());
+    gil::rgba8_image_t image{};
+    gil::read_and_convert_image(in, image, gil::png_tag{});
+    return toPixelData(image);
 }
 #else
-void Texture::load(const fs::path& path) {
-    m_image.load(path);
+static PixelData toPixelData(const Image& image) {
+    auto first{ image.getPixels() };
+    auto size{ static_cast<std::size_t>(image.getWidth() * image.getHeight()) * 4 };
+
+    return { .pixels = { first, first + size },
+             .width = static_cast<std::size_t>(image.getWidth()),
+             .height = static_cast<std::size_t>(image.getHeight()) };
+}
 
-    load(m_image.getPixels(), m_image.getWidth(), m_image.getHeight());
+static PixelData decodePng(const fs::path& path) {
+    Image image{};
+    image.load(path);
+    return toPixelData(image);
+}
+
+static PixelData decodePng(std::span<const std::byte> file) {
+    Image image{};
+    image.load(file);
+    return toPixelData(image);
 }
 #endif
 
-void Texture::load(const void* pixels, std::size_t width, std::size_t height) {
-    if (m_copied) {
-        glDeleteTextures(1, &m_texture);
-        openGLCheck();
+// Whether the cooked file can stand in for the image: edited PNGs still show up
+// while developing.
+static bool isCookedUpToDate(const fs::path& path, const fs::path& cookedPath) {
+#ifndef __ANDROID__
+    std::error_code error{};
+    auto cookedTime{ fs::last_write_time(cookedPath, error) };
+    if (error) return false;
+
+    auto imageTime{ fs::last_write_time(path, error) };
+    return error || imageTime <= cookedTime;
+#else
+    // Assets inside the APK have no times and are only found by opening them.
+    SDL_RWops* io{ SDL_RWFromFile(cookedPath.c_str(), "rb") };
+    if (io == nullptr) return false;
+
+    io->close(io);
+    return true;
+#endif
+}
+
+fs::path findImageFile(const fs::path& path) {
+    auto cookedPath{ fs::path{ path }.replace_extension(cooked_texture_extension) };
+    return isCookedUpToDate(path, cookedPath) ? cookedPath : path;
+}
+
+static std::optional<MappedFile> openCooked(const fs::path& path) {
+    auto file{ findImageFile(path) };
+    if (file.extension() != cooked_texture_extension) return std::nullopt;
+
+    return MappedFile{ file };
+}
+
+static bool isCooked(std::span<const std::byte> file) noexcept {
+    return file.size() >= cooked_texture_magic.size() &&
+           std::memcmp(file.data(), cooked_texture_magic.data(), cooked_texture_magic.size()) == 0;
+}
+
+static CookedTextureHeader readCookedHeader(std::span<const std::byte> file) {
+    CookedTextureHeader header{};
+    if (file.size() < sizeof(header))
+        throw std::runtime_error{ "Error : readCookedHeader : file is too small"s };
+
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (header.magic != cooked_texture_magic || header.version != cooked_texture_version)
+        throw std::runtime_error{ "Error : readCookedHeader : not a cooked texture"s };
+
+    if (header.format != CookedTextureFormat::rgba8_premultiplied)
+        throw std::runtime_error{ "Error : readCookedHeader : unknown format"s };
+
+    if (header.width == 0 || header.height == 0 || header.mipCount == 0 ||
+        header.mipCount > getFullMipCount(header.width, header.height))
+        throw std::runtime_error{ "Error : readCookedHeader : bad size"s };
+
+    if (file.size() < getMipOffset(header, header.mipCount))
+        throw std::runtime_error{ "Error : readCookedHeader : file is truncated"s };
+
+    return header;
+}
+
+// Linear filtering, between mip levels too when there are any.
+static void setSampling(std::uint32_t mipCount) {
+    glTexParameteri(GL_TEXTURE_2D,
+                    GL_TEXTURE_MIN_FILTER,
+                    mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    openGLCheck();
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    openGLCheck();
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipCount - 1));
+    openGLCheck();
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    openGLCheck();
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    openGLCheck();
+}
+
+PixelData decodeImage(const fs::path& path) {
+    if (auto cooked{ openCooked(path) }) return decodeImage(cooked->getData());
+
+    auto image{ decodePng(path) };
+    premultiply(image.pixels);
+    return image;
+}
+
+PixelData decodeImage(std::span<const std::byte> file) {
+    if (isCooked(file)) {
+        auto header{ readCookedHeader(file) };
+
+        auto first{ reinterpret_cast<const std::uint8_t*>(file.data()) + getMipOffset(header, 0) };
+        auto size{ static_cast<std::size_t>(header.width) * header.height * 4 };
+        return { .pixels = { first, first + size },
+                 .width = header.width,
+                 .height = header.height };
+    }
+
+    auto image{ decodePng(file) };
+    premultiply(image.pixels);
+    return image;
+}
+
+void Texture::load(const fs::path& path) {
+    if (auto cooked{ openCooked(path) }) {
+        loadCooked(cooked->getData());
+        return;
     }
 
+    auto image{ decodePng(path) };
+    premultiply(image.pixels);
+    load(image.pixels.data(), image.width, image.height);
+}
+
+void Texture::load(std::span<const std::byte> file) {
+    if (isCooked(file)) {
+        loadCooked(file);
+        return;
+    }
+
+    auto image{ decodeImage(file) };
+    load(image.pixels.data(), image.width, image.height);
+}
+
+void Texture::load(const void* pixels, std::size_t width, std::size_t height) {
+    release();
+
     glGenTextures(1, &m_texture);
     openGLCheck();
 
@@ -42,6 +224,8 @@ void Texture::load(const void* pixels, std::size_t width, std::size_t height) {
 
     m_width = width;
     m_height = height;
+    m_region = { .xy = { 0.0f, 0.0f }, .wh = { 1.0f, 1.0f } };
+    m_isOwner = true;
 
     glTexImage2D(GL_TEXTURE_2D,
                  0,
@@ -54,17 +238,39 @@ void Texture::load(const void* pixels, std::size_t width, std::size_t height) {
                  pixels);
     openGLCheck();
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    openGLCheck();
+    setSampling(1);
+}
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    openGLCheck();
+void Texture::loadCooked(std::span<const std::byte> file) {
+    auto header{ readCookedHeader(file) };
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    openGLCheck();
+    release();
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glGenTextures(1, &m_texture);
     openGLCheck();
+
+    bind();
+
+    m_width = header.width;
+    m_height = header.height;
+    m_region = { .xy = { 0.0f, 0.0f }, .wh = { 1.0f, 1.0f } };
+    m_isOwner = true;
+
+    // Levels go to GL straight from the mapping, rows of RGBA8 are always 4-byte aligned.
+    for (std::uint32_t level{}; level < header.mipCount; ++level) {
+        glTexImage2D(GL_TEXTURE_2D,
+                     static_cast<GLint>(level),
+                     GL_RGBA,
+                     static_cast<GLsizei>(getMipWidth(header, level)),
+                     static_cast<GLsizei>(getMipHeight(header, level)),
+                     0,
+                     GL_RGBA,
+                     GL_UNSIGNED_BYTE,
+                     file.data() + getMipOffset(header, level));
+        openGLCheck();
+    }
+
+    setSampling(header.mipCount);
 }
 
 std::uint32_t Texture::operator*() const noexcept { return m_texture; }
@@ -73,27 +279,48 @@ std::size_t Texture::getWidth() const noexcept { return m_width; }
 
 std::size_t Texture::getHeight() const noexcept { return m_height; }
 
-void Texture::bind() const {
-    glBindTexture(GL_TEXTURE_2D, m_texture);
-    openGLCheck();
-}
+const Rectangle& Texture::getRegion() const noexcept { return m_region; }
 
-Texture::Texture(Texture& texture)
-    : m_texture{ texture.m_texture }, m_width{ texture.m_width }, m_height{ texture.m_height } {
-    texture.m_copied = true;
+bool Texture::hasRegion() const noexcept {
+    return m_region != Rectangle{ .xy = { 0.0f, 0.0f }, .wh = { 1.0f, 1.0f } };
 }
 
-Texture& Texture::operator=(Texture& texture) {
+void Texture::bind() const { RenderState::getInstance().bindTexture(m_texture); }
+
+Texture::Texture(const Texture& texture)
+    : m_texture{ texture.m_texture }
+    , m_width{ texture.m_width }
+    , m_height{ texture.m_height }
+    , m_region{ texture.m_region } {}
+
+Texture::Texture(const Texture& texture, const Rectangle& region)
+    : m_texture{ texture.m_texture }
+    , m_width{ static_cast<std::size_t>(region.wh.width) }
+    , m_height{ static_cast<std::size_t>(region.wh.height) }
+    , m_region{ .xy = { region.xy.x / texture.m_width, region.xy.y / texture.m_height },
+                .wh = { region.wh.width / texture.m_width,
+                        region.wh.height / texture.m_height } } {}
+
+Texture& Texture::operator=(const Texture& texture) {
+    if (this == &texture) return *this;
+
+    release();
     m_texture = texture.m_texture;
     m_width = texture.m_width;
     m_height = texture.m_height;
-    texture.m_copied = true;
+    m_region = texture.m_region;
     return *this;
 }
 
-#ifdef __ANDROID__
-#    include <SDL3/SDL.h>
+void Texture::release() noexcept {
+    if (!m_isOwner) return;
+
+    RenderState::getInstance().forgetTexture(m_texture);
+    glDeleteTextures(1, &m_texture);
+    m_isOwner = false;
+}
 
+#ifdef __ANDROID__
 #    define STB_IMAGE_IMPLEMENTATION
 #    include "stb_image.h"
 
@@ -114,15 +341,21 @@ Image::~Image() {
 }
 
 void Image::load(const fs::path& path) {
-    int channels{};
     auto imageFile{ readFile(path) };
+    load(std::as_bytes(std::span{ imageFile }));
+}
+
+void Image::load(std::span<const std::byte> file) {
+    int channels{};
     if (m_image != nullptr) stbi_image_free(m_image);
-    m_image = stbi_load_from_memory(reinterpret_cast<const unsigned char*>(imageFile.data()),
-                                    imageFile.size(),
+    m_image = stbi_load_from_memory(reinterpret_cast<const unsigned char*>(file.data()),
+                                    static_cast<int>(file.size()),
                                     &m_width,
                                     &m_height,
                                     &channels,
-                                    0);
+                                    4);
+    if (m_image == nullptr)
+        throw std::runtime_error{ "Error : Image::load : "s + stbi_failure_reason() };
 }
 
 std::vector<char> Image::readFile(const fs::path& path) {
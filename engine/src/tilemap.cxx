@@ -0,0 +1,165 @@
+#include "tilemap.hxx"
+
+#include <algorithm>
+#include <glad/glad.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "opengl_check.hxx"
+#include "render_state.hxx"
+
+using namespace std::literals;
+
+Tilemap::Tilemap(std::size_t columns, std::size_t rows, const std::vector<fs::path>& tileset)
+    : Tilemap{ columns, rows, std::make_shared<const Tileset>(tileset) } {}
+
+Tilemap::Tilemap(std::size_t columns, std::size_t rows, std::shared_ptr<const Tileset> tileset)
+    : m_columns{ columns }
+    , m_rows{ rows }
+    , m_tiles(columns * rows, s_empty)
+    , m_tileset{ std::move(tileset) } {
+    if (m_columns == 0 || m_rows == 0)
+        throw std::runtime_error{ "Error : Tilemap::Tilemap : empty grid"s };
+
+    if (!m_tileset) throw std::runtime_error{ "Error : Tilemap::Tilemap : no tileset"s };
+
+    // Rows of one byte texels are not 4-byte aligned.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    openGLCheck();
+
+    glGenTextures(1, &m_tileTexture);
+    openGLCheck();
+
+    RenderState::getInstance().bindTexture(m_tileTexture);
+
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 GL_R8,
+                 static_cast<GLsizei>(m_columns),
+                 static_cast<GLsizei>(m_rows),
+                 0,
+                 GL_RED,
+                 GL_UNSIGNED_BYTE,
+                 m_tiles.data());
+    openGLCheck();
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    openGLCheck();
+
+    // Ids are fetched with texelFetch, filtering them would blend unrelated tiles.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    openGLCheck();
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    openGLCheck();
+}
+
+Tilemap::~Tilemap() {
+    RenderState::getInstance().forgetTexture(m_tileTexture);
+    glDeleteTextures(1, &m_tileTexture);
+}
+
+void Tilemap::setTile(std::size_t column, std::size_t row, std::uint8_t id) {
+    if (column >= m_columns || row >= m_rows)
+        throw std::runtime_error{ "Error : Tilemap::setTile : tile is out of the grid"s };
+
+    if (id > m_tileset->getSize())
+        throw std::runtime_error{ "Error : Tilemap::setTile : id is not in the tileset"s };
+
+    auto& tile{ m_tiles[row * m_columns + column] };
+    if (tile == id) return;
+
+    tile = id;
+    markDirty(column, column + 1, row, row + 1);
+}
+
+void Tilemap::fill(std::uint8_t id) {
+    if (id > m_tileset->getSize())
+        throw std::runtime_error{ "Error : Tilemap::fill : id is not in the tileset"s };
+
+    std::ranges::fill(m_tiles, id);
+    markDirty(0, m_columns, 0, m_rows);
+}
+
+void Tilemap::setTiles(std::span<const std::uint8_t> tiles) {
+    if (tiles.size() != m_tiles.size())
+        throw std::runtime_error{ "Error : Tilemap::setTiles : size does not match the grid"s };
+
+    if (std::ranges::any_of(tiles, [this](std::uint8_t id) { return id > m_tileset->getSize(); }))
+        throw std::runtime_error{ "Error : Tilemap::setTiles : id is not in the tileset"s };
+
+    std::ranges::copy(tiles, m_tiles.begin());
+    markDirty(0, m_columns, 0, m_rows);
+}
+
+std::uint8_t Tilemap::getTile(std::size_t column, std::size_t row) const {
+    if (column >= m_columns || row >= m_rows)
+        throw std::runtime_error{ "Error : Tilemap::getTile : tile is out of the grid"s };
+
+    return m_tiles[row * m_columns + column];
+}
+
+void Tilemap::upload() {
+    if (m_dirtyFirstColumn >= m_dirtyLastColumn || m_dirtyFirstRow >= m_dirtyLastRow) return;
+
+    RenderState::getInstance().bindTexture(m_tileTexture);
+
+    // The rectangle is read out of the whole grid, row by row.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    openGLCheck();
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(m_columns));
+    openGLCheck();
+
+    glTexSubImage2D(GL_TEXTURE_2D,
+                    0,
+                    static_cast<GLint>(m_dirtyFirstColumn),
+                    static_cast<GLint>(m_dirtyFirstRow),
+                    static_cast<GLsizei>(m_dirtyLastColumn - m_dirtyFirstColumn),
+                    static_cast<GLsizei>(m_dirtyLastRow - m_dirtyFirstRow),
+                    GL_RED,
+                    GL_UNSIGNED_BYTE,
+                    m_tiles.data() + m_dirtyFirstRow * m_columns + m_dirtyFirstColumn);
+    openGLCheck();
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    openGLCheck();
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    openGLCheck();
+
+    m_dirtyFirstColumn = m_dirtyLastColumn = m_dirtyFirstRow = m_dirtyLastRow = 0;
+}
+
+void Tilemap::bind(std::uint32_t tileUnit, std::uint32_t tilesetUnit) const {
+    auto& renderState{ RenderState::getInstance() };
+    renderState.bindTexture(m_tileTexture, tileUnit);
+    m_tileset->bind(tilesetUnit);
+}
+
+std::size_t Tilemap::getColumns() const noexcept { return m_columns; }
+
+std::size_t Tilemap::getRows() const noexcept { return m_rows; }
+
+std::size_t Tilemap::getTilesetSize() const noexcept { return m_tileset->getSize(); }
+
+std::uint32_t Tilemap::operator*() const noexcept { return m_tileTexture; }
+
+void Tilemap::markDirty(std::size_t firstColumn,
+                        std::size_t lastColumn,
+                        std::size_t firstRow,
+                        std::size_t lastRow) noexcept {
+    if (m_dirtyFirstColumn >= m_dirtyLastColumn || m_dirtyFirstRow >= m_dirtyLastRow) {
+        m_dirtyFirstColumn = firstColumn;
+        m_dirtyLastColumn = lastColumn;
+        m_dirtyFirstRow = firstRow;
+        m_dirtyLastRow = lastRow;
+        return;
+    }
+
+    m_dirtyFirstColumn = std::min(m_dirtyFirstColumn, firstColumn);
+    m_dirtyLastColumn = std::max(m_dirtyLastColumn, lastColumn);
+    m_dirtyFirstRow = std::min(m_dirtyFirstRow, firstRow);
+    m_dirtyLastRow = std::max(m_dirtyLastRow, lastRow);
+}
@@ -0,0 +1,87 @@
+#include "tileset.hxx"
+
+#include <glad/glad.h>
+#include <stdexcept>
+#include <string>
+
+#include "asset_registry.hxx"
+#include "opengl_check.hxx"
+#include "render_state.hxx"
+#include "texture.hxx"
+
+using namespace std::literals;
+
+Tileset::Tileset(const std::vector<fs::path>& images) {
+    if (images.empty() || images.size() > 255)
+        throw std::runtime_error{ "Error : Tileset::Tileset : tileset must hold 1 to 255 images"s };
+
+    std::vector<PixelData> pixels{};
+    pixels.reserve(images.size());
+    for (const auto& path : images) {
+        pixels.push_back(AssetRegistry::getInstance().readImage(path));
+
+        if (pixels.back().width != pixels.front().width ||
+            pixels.back().height != pixels.front().height)
+            throw std::runtime_error{ "Error : Tileset::Tileset : tile images differ in size: "s +
+                                      path.string() };
+    }
+
+    m_size = pixels.size();
+
+    glGenTextures(1, &m_texture);
+    openGLCheck();
+
+    RenderState::getInstance().bindTextureArray(m_texture);
+
+    glTexImage3D(GL_TEXTURE_2D_ARRAY,
+                 0,
+                 GL_RGBA8,
+                 static_cast<GLsizei>(pixels.front().width),
+                 static_cast<GLsizei>(pixels.front().height),
+                 static_cast<GLsizei>(pixels.size()),
+                 0,
+                 GL_RGBA,
+                 GL_UNSIGNED_BYTE,
+                 nullptr);
+    openGLCheck();
+
+    for (std::size_t layer{}; layer < pixels.size(); ++layer) {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
+                        0,
+                        0,
+                        0,
+                        static_cast<GLint>(layer),
+                        static_cast<GLsizei>(pixels[layer].width),
+                        static_cast<GLsizei>(pixels[layer].height),
+                        1,
+                        GL_RGBA,
+                        GL_UNSIGNED_BYTE,
+                        pixels[layer].pixels.data());
+        openGLCheck();
+    }
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    openGLCheck();
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    openGLCheck();
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    openGLCheck();
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    openGLCheck();
+}
+
+Tileset::~Tileset() {
+    RenderState::getInstance().forgetTexture(m_texture);
+    glDeleteTextures(1, &m_texture);
+}
+
+void Tileset::bind(std::uint32_t unit) const {
+    RenderState::getInstance().bindTextureArray(m_texture, unit);
+}
+
+std::size_t Tileset::getSize() const noexcept { return m_size; }
+
+std::uint32_t Tileset::operator*() const noexcept { return m_texture; }
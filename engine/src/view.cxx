@@ -24,3 +24,13 @@ Position View::getPosition() const noexcept {
 void View::setScale(float scale) { m_scale = scale; }
 
 float View::getScale() const noexcept { return m_scale; }
+
+Rectangle View::getVisibleRectangle() const {
+    auto windowSize{ getEngineInstance()->getWindowSize() };
+    Size size{ static_cast<float>(windowSize.width) / m_scale,
+               static_cast<float>(windowSize.height) / m_scale };
+    auto position{ getPosition() };
+
+    return { .xy = { position.x - size.width / 2.0f, position.y - size.height / 2.0f },
+             .wh = size };
+}
@@ -0,0 +1,151 @@
+// Packs directories into one asset pack, see asset_pack.hxx for the format.
+// Files are named by their path from the parent of the given directory, so
+// packing data gives names like "data/assets/coin.png". Cooked textures older
+// than their PNG are left out, as the engine would not load them either.
+//
+//     asset_packer <output pack> <directory>...
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "asset_pack.hxx"
+#include "cooked_texture.hxx"
+
+namespace fs = std::filesystem;
+using namespace std::literals;
+
+struct PackedFile
+{
+    std::string name{};
+    fs::path path{};
+    std::uint64_t size{};
+};
+
+static bool isStaleCooked(const fs::path& path) {
+    if (path.extension() != cooked_texture_extension) return false;
+
+    std::error_code error{};
+    auto imageTime{ fs::last_write_time(fs::path{ path }.replace_extension(".png"sv), error) };
+    return !error && imageTime > fs::last_write_time(path);
+}
+
+static std::vector<PackedFile> collectFiles(const std::vector<fs::path>& directories,
+                                            const fs::path& output) {
+    std::vector<PackedFile> files{};
+
+    for (const auto& directory : directories) {
+        if (!fs::is_directory(directory))
+            throw std::runtime_error{ "Error : collectFiles : not a directory "s +
+                                      directory.string() };
+
+        auto root{ fs::absolute(directory).lexically_normal().parent_path() };
+
+        for (const auto& entry : fs::recursive_directory_iterator{ directory }) {
+            if (!entry.is_regular_file() || isStaleCooked(entry.path())) continue;
+
+            std::error_code error{};
+            if (fs::equivalent(entry.path(), output, error)) continue;
+
+            auto name{ fs::absolute(entry.path()).lexically_normal().lexically_relative(root) };
+            files.push_back({ .name = name.generic_string(),
+                              .path = entry.path(),
+                              .size = static_cast<std::uint64_t>(entry.file_size()) });
+        }
+    }
+
+    std::ranges::sort(files, {}, &PackedFile::name);
+
+    if (auto duplicate{ std::ranges::adjacent_find(files, {}, &PackedFile::name) };
+        duplicate != files.end())
+        throw std::runtime_error{ "Error : collectFiles : two files named "s + duplicate->name };
+
+    return files;
+}
+
+static std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + asset_pack_alignment - 1) / asset_pack_alignment * asset_pack_alignment;
+}
+
+static void writePadding(std::ofstream& out, std::uint64_t offset) {
+    static constexpr std::array<char, asset_pack_alignment> zeros{};
+    out.write(zeros.data(), static_cast<std::streamsize>(alignUp(offset) - offset));
+}
+
+static void writePack(const fs::path& output, const std::vector<PackedFile>& files) {
+    AssetPackHeader header{ .magic = asset_pack_magic,
+                            .version = asset_pack_version,
+                            .entryCount = static_cast<std::uint32_t>(files.size()) };
+    header.namesOffset = sizeof(header) + files.size() * sizeof(AssetPackEntry);
+
+    std::vector<AssetPackEntry> entries(files.size());
+    std::string names{};
+    for (std::size_t i{}; i < files.size(); ++i) {
+        entries[i].nameOffset = static_cast<std::uint32_t>(names.size());
+        entries[i].nameSize = static_cast<std::uint32_t>(files[i].name.size());
+        names += files[i].name;
+    }
+    header.namesSize = names.size();
+
+    auto offset{ alignUp(header.namesOffset + header.namesSize) };
+    for (std::size_t i{}; i < files.size(); ++i) {
+        entries[i].offset = offset;
+        entries[i].size = files[i].size;
+        offset = alignUp(offset + files[i].size);
+    }
+
+    std::ofstream out{ output, std::ios::binary };
+    if (!out.is_open()) throw std::runtime_error{ "Error : writePack : bad open file"s };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(AssetPackEntry)));
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+    writePadding(out, header.namesOffset + header.namesSize);
+
+    for (std::size_t i{}; i < files.size(); ++i) {
+        std::ifstream in{ files[i].path, std::ios::binary };
+        if (!in.is_open())
+            throw std::runtime_error{ "Error : writePack : bad open file "s +
+                                      files[i].path.string() };
+
+        // Streaming an empty buffer would set failbit on out.
+        if (files[i].size > 0) out << in.rdbuf();
+        writePadding(out, entries[i].offset + entries[i].size);
+    }
+
+    if (!out) throw std::runtime_error{ "Error : writePack : bad write file"s };
+
+    std::cout << output.string() << " : "sv << files.size() << " files, "sv << offset << " bytes"sv
+              << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage : asset_packer <output pack> <directory>..."sv << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        fs::path output{ argv[1] };
+        std::vector<fs::path> directories(argv + 2, argv + argc);
+
+        writePack(output, collectFiles(directories, output));
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+// Cooks PNG images into .ctex files next to them, see cooked_texture.hxx for the
+// format. Directories are searched recursively for PNGs.
+//
+//     texture_cooker [--mips] <png or directory>...
+
+#include <boost/gil.hpp>
+#include <boost/gil/extension/io/png.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cooked_texture.hxx"
+
+namespace fs = std::filesystem;
+namespace gil = boost::gil;
+using namespace std::literals;
+
+static std::vector<std::uint8_t> readPremultiplied(const fs::path& path,
+                                                   CookedTextureHeader& header) {
+    gil::rgba8_image_t image{};
+    gil::read_and_convert_image(path.string(), image, gil::png_tag{});
+
+    header.width = static_cast<std::uint32_t>(image.width());
+    header.height = static_cast<std::uint32_t>(image.height());
+
+    auto first{ gil::interleaved_view_get_raw_data(gil::view(image)) };
+    auto size{ std::size_t{ header.width } * header.height * 4 };
+    std::vector<std::uint8_t> pixels(first, first + size);
+
+    for (std::size_t i{}; i < pixels.size(); i += 4) {
+        unsigned alpha{ pixels[i + 3] };
+        for (std::size_t c{}; c < 3; ++c)
+            pixels[i + c] = static_cast<std::uint8_t>((pixels[i + c] * alpha + 127) / 255);
+    }
+
+    return pixels;
+}
+
+// Box filter of the 2x2 texels under every texel of the next level; premultiplied
+// colours average without dark fringes around transparent texels.
+static std::vector<std::uint8_t> downsample(const std::vector<std::uint8_t>& pixels,
+                                            std::size_t width,
+                                            std::size_t height) {
+    auto nextWidth{ std::max<std::size_t>(width / 2, 1) };
+    auto nextHeight{ std::max<std::size_t>(height / 2, 1) };
+    std::vector<std::uint8_t> next(nextWidth * nextHeight * 4);
+
+    for (std::size_t y{}; y < nextHeight; ++y) {
+        for (std::size_t x{}; x < nextWidth; ++x) {
+            auto x0{ std::min(x * 2, width - 1) };
+            auto x1{ std::min(x * 2 + 1, width - 1) };
+            auto y0{ std::min(y * 2, height - 1) };
+            auto y1{ std::min(y * 2 + 1, height - 1) };
+
+            for (std::size_t c{}; c < 4; ++c) {
+                auto sum{ static_cast<unsigned>(pixels[(y0 * width + x0) * 4 + c] +
+                                                pixels[(y0 * width + x1) * 4 + c] +
+                                                pixels[(y1 * width + x0) * 4 + c] +
+                                                pixels[(y1 * width + x1) * 4 + c]) };
+                next[(y * nextWidth + x) * 4 + c] = static_cast<std::uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+
+    return next;
+}
+
+static void cook(const fs::path& path, bool withMips) {
+    CookedTextureHeader header{ .magic = cooked_texture_magic,
+                                .version = cooked_texture_version,
+                                .format = CookedTextureFormat::rgba8_premultiplied };
+
+    auto pixels{ readPremultiplied(path, header) };
+    header.mipCount = withMips ? getFullMipCount(header.width, header.height) : 1;
+
+    auto cookedPath{ fs::path{ path }.replace_extension(cooked_texture_extension) };
+    std::ofstream out{ cookedPath, std::ios::binary };
+    if (!out.is_open()) throw std::runtime_error{ "Error : cook : bad open file"s };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (std::uint32_t level{}; level < header.mipCount; ++level) {
+        if (level > 0)
+            pixels = downsample(
+                pixels, getMipWidth(header, level - 1), getMipHeight(header, level - 1));
+
+        out.write(reinterpret_cast<const char*>(pixels.data()),
+                  static_cast<std::streamsize>(pixels.size()));
+    }
+
+    if (!out) throw std::runtime_error{ "Error : cook : bad write file"s };
+
+    std::cout << path.string() << " -> "sv << cookedPath.string() << " ("sv << header.width << 'x'
+              << header.height << ", "sv << header.mipCount << " levels)"sv << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    bool withMips{};
+    std::vector<fs::path> inputs{};
+
+    for (int i{ 1 }; i < argc; ++i) {
+        if (argv[i] == "--mips"sv)
+            withMips = true;
+        else
+            inputs.emplace_back(argv[i]);
+    }
+
+    if (inputs.empty()) {
+        std::cerr << "Usage : texture_cooker [--mips] <png or directory>..."sv << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        for (const auto& input : inputs) {
+            if (!fs::is_directory(input)) {
+                cook(input, withMips);
+                continue;
+            }
+
+            for (const auto& entry : fs::recursive_directory_iterator{ input })
+                if (entry.is_regular_file() && entry.path().extension() == ".png"sv)
+                    cook(entry.path(), withMips);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+#include "collision_grid.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+CollisionGrid::CollisionGrid(const MapFile& file)
+    : m_words{ file.getCollision() }
+    , m_columns{ file.getHeader().columns }
+    , m_rows{ file.getHeader().rows }
+    , m_stride{ getCollisionStride(m_columns) }
+    , m_origin{ file.getHeader().originX, file.getHeader().originY }
+    , m_tileSize{ file.getTileSize() } {}
+
+bool CollisionGrid::isSolid(std::ptrdiff_t column, std::ptrdiff_t row) const noexcept {
+    if (column < 0 || row < 0 || static_cast<std::size_t>(column) >= m_columns ||
+        static_cast<std::size_t>(row) >= m_rows)
+        return false;
+
+    auto word{ m_words[static_cast<std::size_t>(row) * m_stride +
+                       static_cast<std::size_t>(column) / 64] };
+    return (word >> (static_cast<std::size_t>(column) % 64) & 1) != 0;
+}
+
+bool CollisionGrid::isSolid(Position position) const noexcept {
+    auto column{ std::floor((position.x - m_origin.x) / m_tileSize.width) };
+    auto row{ std::floor((position.y - m_origin.y) / m_tileSize.height) };
+
+    return isSolid(static_cast<std::ptrdiff_t>(column), static_cast<std::ptrdiff_t>(row));
+}
+
+bool CollisionGrid::isSolid(const Rectangle& rectangle) const noexcept {
+    // Tiles touched by the rectangle, inclusive and clamped to the grid.
+    auto left{ (rectangle.xy.x - m_origin.x) / m_tileSize.width };
+    auto right{ (rectangle.xy.x + rectangle.wh.width - m_origin.x) / m_tileSize.width };
+    auto bottom{ (rectangle.xy.y - m_origin.y) / m_tileSize.height };
+    auto top{ (rectangle.xy.y + rectangle.wh.height - m_origin.y) / m_tileSize.height };
+
+    auto firstColumn{ std::max(std::floor(left), 0.0f) };
+    auto lastColumn{ std::min(std::ceil(right) - 1.0f, static_cast<float>(m_columns) - 1.0f) };
+    auto firstRow{ std::max(std::floor(bottom), 0.0f) };
+    auto lastRow{ std::min(std::ceil(top) - 1.0f, static_cast<float>(m_rows) - 1.0f) };
+
+    if (firstColumn > lastColumn || firstRow > lastRow) return false;
+
+    auto first{ static_cast<std::size_t>(firstColumn) };
+    auto last{ static_cast<std::size_t>(lastColumn) };
+
+    // Each row is tested a word, 64 tiles, at a time.
+    for (auto row{ static_cast<std::size_t>(firstRow) }; row <= static_cast<std::size_t>(lastRow);
+         ++row)
+        for (auto word{ first / 64 }; word <= last / 64; ++word) {
+            auto mask{ ~std::uint64_t{} };
+            if (word == first / 64) mask &= ~std::uint64_t{} << first % 64;
+            if (word == last / 64) mask &= ~std::uint64_t{} >> (63 - last % 64);
+
+            if ((m_words[row * m_stride + word] & mask) != 0) return true;
+        }
+
+    return false;
+}
+
+std::optional<Position> CollisionGrid::raycast(Position from, Position to) const noexcept {
+    // Amanatides and Woo: step to whichever tile border the segment crosses next.
+    auto x{ (from.x - m_origin.x) / m_tileSize.width };
+    auto y{ (from.y - m_origin.y) / m_tileSize.height };
+    auto dx{ (to.x - m_origin.x) / m_tileSize.width - x };
+    auto dy{ (to.y - m_origin.y) / m_tileSize.height - y };
+
+    auto column{ static_cast<std::ptrdiff_t>(std::floor(x)) };
+    auto row{ static_cast<std::ptrdiff_t>(std::floor(y)) };
+
+    constexpr auto infinity{ std::numeric_limits<float>::infinity() };
+    std::ptrdiff_t stepX{ dx > 0.0f ? 1 : dx < 0.0f ? -1 : 0 };
+    std::ptrdiff_t stepY{ dy > 0.0f ? 1 : dy < 0.0f ? -1 : 0 };
+    auto deltaX{ stepX != 0 ? 1.0f / std::abs(dx) : infinity };
+    auto deltaY{ stepY != 0 ? 1.0f / std::abs(dy) : infinity };
+    // Segment parameter of the next vertical and horizontal border.
+    auto nextX{ stepX > 0   ? (static_cast<float>(column) + 1.0f - x) * deltaX
+                : stepX < 0 ? (x - static_cast<float>(column)) * deltaX
+                            : infinity };
+    auto nextY{ stepY > 0   ? (static_cast<float>(row) + 1.0f - y) * deltaY
+                : stepY < 0 ? (y - static_cast<float>(row)) * deltaY
+                            : infinity };
+
+    for (float t{}; t <= 1.0f;) {
+        if (isSolid(column, row))
+            return Position{ m_origin.x + (x + dx * t) * m_tileSize.width,
+                             m_origin.y + (y + dy * t) * m_tileSize.height };
+
+        if (nextX < nextY) {
+            t = nextX;
+            nextX += deltaX;
+            column += stepX;
+        }
+        else {
+            t = nextY;
+            nextY += deltaY;
+            row += stepY;
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool CollisionGrid::isVisible(Position from, Position to) const noexcept {
+    return !raycast(from, to).has_value();
+}
+
+std::size_t CollisionGrid::getColumns() const noexcept { return m_columns; }
+
+std::size_t CollisionGrid::getRows() const noexcept { return m_rows; }
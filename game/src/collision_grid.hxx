@@ -0,0 +1,43 @@
+#ifndef ENGINE_PREPARE_TO_GAME_COLLISION_GRID_HXX
+#define ENGINE_PREPARE_TO_GAME_COLLISION_GRID_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <structures.hxx>
+
+#include "map_file.hxx"
+
+// Land tiles of the whole world as one bit per tile, read in place from the
+// collision mask of a map file. Point and rectangle queries are a few bit tests
+// however many islands there are. Tiles outside the grid are water.
+class CollisionGrid final
+{
+private:
+    std::span<const std::uint64_t> m_words{};
+    std::size_t m_columns{};
+    std::size_t m_rows{};
+    std::size_t m_stride{};
+    Position m_origin{};
+    Size m_tileSize{};
+
+public:
+    // The file must outlive the grid.
+    explicit CollisionGrid(const MapFile& file);
+
+    [[nodiscard]] bool isSolid(std::ptrdiff_t column, std::ptrdiff_t row) const noexcept;
+    [[nodiscard]] bool isSolid(Position position) const noexcept;
+    // Whether any tile the rectangle overlaps is land.
+    [[nodiscard]] bool isSolid(const Rectangle& rectangle) const noexcept;
+
+    // Walks the tiles crossed by the segment in order and returns the point where
+    // it enters the first land tile, if any.
+    [[nodiscard]] std::optional<Position> raycast(Position from, Position to) const noexcept;
+    [[nodiscard]] bool isVisible(Position from, Position to) const noexcept;
+
+    [[nodiscard]] std::size_t getColumns() const noexcept;
+    [[nodiscard]] std::size_t getRows() const noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_COLLISION_GRID_HXX
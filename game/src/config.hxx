@@ -18,6 +18,20 @@ struct Config
     inline static Event::Keyboard::Key dig_treasure_key{ Event::Keyboard::Key::f };
 
     inline static float camera_height{ 1.0f };
+
+    // Islands come from the seed instead of data/maps/islands.map when set.
+    inline static bool generate_islands{ false };
+    inline static std::uint64_t islands_seed{ 1 };
+
+    // Draw order of the scene from back to front.
+    inline static constexpr std::uint8_t water_layer{ 0 };
+    inline static constexpr std::uint8_t island_layer{ 1 };
+    inline static constexpr std::uint8_t bottle_layer{ 2 };
+    inline static constexpr std::uint8_t treasure_layer{ 3 };
+    inline static constexpr std::uint8_t fog_layer{ 4 };
+    inline static constexpr std::uint8_t ship_layer{ 5 };
+    inline static constexpr std::uint8_t player_layer{ 6 };
+    inline static constexpr std::uint8_t x_mark_layer{ 7 };
 };
 
 #endif // ENGINE_PREPARE_TO_GAME_CONFIG_HXX
@@ -0,0 +1,99 @@
+#include "exploration.hxx"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals;
+
+static constexpr DynamicTexture::Color fog_color{ 12, 18, 32, 255 };
+static constexpr DynamicTexture::Color clear_color{ 0, 0, 0, 0 };
+static constexpr DynamicTexture::Color mark_color{ 230, 40, 40, 255 };
+
+// Minimap colours by tile id, see toTileId.
+static constexpr std::array<DynamicTexture::Color, 6> tile_colors{ {
+    { 30, 80, 150, 255 },
+    { 222, 200, 140, 255 },
+    { 170, 180, 100, 255 },
+    { 80, 150, 60, 255 },
+    { 125, 125, 125, 255 },
+    { 40, 110, 40, 255 },
+} };
+
+Exploration::Exploration(const MapFile& file)
+    : m_tiles{ file.getTiles() }
+    , m_columns{ file.getHeader().columns }
+    , m_rows{ file.getHeader().rows }
+    , m_origin{ file.getHeader().originX, file.getHeader().originY }
+    , m_tileSize{ file.getTileSize() }
+    , m_explored(m_columns * m_rows)
+    , m_fog{ m_columns, m_rows, fog_color }
+    , m_minimap{ m_columns, m_rows, fog_color } {}
+
+void Exploration::explore(Position position, std::size_t radius) {
+    auto column{ static_cast<std::ptrdiff_t>(
+        std::floor((position.x - m_origin.x) / m_tileSize.width)) };
+    auto row{ static_cast<std::ptrdiff_t>(
+        std::floor((position.y - m_origin.y) / m_tileSize.height)) };
+
+    // Nothing changes until the explorer enters another tile.
+    if (column == m_column && row == m_row) return;
+
+    auto reach{ static_cast<std::ptrdiff_t>(radius) };
+    for (auto y{ row - reach }; y <= row + reach; ++y)
+        for (auto x{ column - reach }; x <= column + reach; ++x) {
+            if (x < 0 || y < 0 || static_cast<std::size_t>(x) >= m_columns ||
+                static_cast<std::size_t>(y) >= m_rows)
+                continue;
+
+            if ((x - column) * (x - column) + (y - row) * (y - row) <= reach * reach)
+                reveal(static_cast<std::size_t>(x), static_cast<std::size_t>(y));
+        }
+
+    setMark(m_column, m_row, false);
+    setMark(column, row, true);
+    m_column = column;
+    m_row = row;
+}
+
+void Exploration::upload() {
+    m_fog.upload();
+    m_minimap.upload();
+}
+
+bool Exploration::isExplored(std::size_t column, std::size_t row) const {
+    if (column >= m_columns || row >= m_rows)
+        throw std::runtime_error{ "Error : Exploration::isExplored : tile is out of the grid"s };
+
+    return m_explored[row * m_columns + column];
+}
+
+Texture& Exploration::getFog() noexcept { return m_fog.getTexture(); }
+
+Texture& Exploration::getMinimap() noexcept { return m_minimap.getTexture(); }
+
+void Exploration::reveal(std::size_t column, std::size_t row) {
+    auto& explored{ m_explored[row * m_columns + column] };
+    if (explored) return;
+
+    explored = 1;
+
+    // Texture rows go from the top, grid rows from the bottom.
+    auto y{ m_rows - 1 - row };
+    m_fog.setPixel(column, y, clear_color);
+    m_minimap.setPixel(column, y, tile_colors.at(m_tiles[row * m_columns + column]));
+}
+
+void Exploration::setMark(std::ptrdiff_t column, std::ptrdiff_t row, bool isMarked) {
+    if (column < 0 || row < 0 || static_cast<std::size_t>(column) >= m_columns ||
+        static_cast<std::size_t>(row) >= m_rows)
+        return;
+
+    auto index{ static_cast<std::size_t>(row) * m_columns + static_cast<std::size_t>(column) };
+    auto color{ isMarked           ? mark_color
+                : m_explored[index] ? tile_colors.at(m_tiles[index])
+                                    : fog_color };
+    m_minimap.setPixel(
+        static_cast<std::size_t>(column), m_rows - 1 - static_cast<std::size_t>(row), color);
+}
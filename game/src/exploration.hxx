@@ -0,0 +1,53 @@
+#ifndef ENGINE_PREPARE_TO_GAME_EXPLORATION_HXX
+#define ENGINE_PREPARE_TO_GAME_EXPLORATION_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <dynamic_texture.hxx>
+#include <span>
+#include <structures.hxx>
+#include <texture.hxx>
+#include <vector>
+
+#include "map_file.hxx"
+
+// Tiles seen so far, kept as two textures of one texel per tile: a fog that is
+// opaque over unexplored tiles, laid over the world, and a minimap with the tile
+// colours of explored tiles and a mark at the explorer. Only the tiles revealed
+// since the last frame are uploaded; a step into the next tile changes one arc of
+// the reveal circle, a few hundred bytes at most.
+class Exploration final
+{
+private:
+    std::span<const std::uint8_t> m_tiles{};
+    std::size_t m_columns{};
+    std::size_t m_rows{};
+    Position m_origin{};
+    Size m_tileSize{};
+
+    std::vector<std::uint8_t> m_explored{};
+    DynamicTexture m_fog;
+    DynamicTexture m_minimap;
+
+    // Tile of the last explore(), marked on the minimap.
+    std::ptrdiff_t m_column{ -1 };
+    std::ptrdiff_t m_row{ -1 };
+
+public:
+    // The file must outlive the exploration.
+    explicit Exploration(const MapFile& file);
+
+    // Reveals the tiles within radius tiles around position.
+    void explore(Position position, std::size_t radius);
+    void upload();
+
+    [[nodiscard]] bool isExplored(std::size_t column, std::size_t row) const;
+    [[nodiscard]] Texture& getFog() noexcept;
+    [[nodiscard]] Texture& getMinimap() noexcept;
+
+private:
+    void reveal(std::size_t column, std::size_t row);
+    void setMark(std::ptrdiff_t column, std::ptrdiff_t row, bool isMarked);
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_EXPLORATION_HXX
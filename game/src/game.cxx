@@ -3,9 +3,12 @@
 #include <engine.hxx>
 #include <memory>
 #include <stdexcept>
+#include <string_view>
+#include <system_error>
 
 #include "config.hxx"
 #include "island.hxx"
+#include "island_generator.hxx"
 #include "map.hxx"
 #include "menu.hxx"
 #include "player.hxx"
@@ -20,12 +23,16 @@ class PirateGame final : public IGame
 private:
     inline static constexpr Size s_originalWindowSize{ 800, 600 };
     inline static constexpr int s_deltaForTouches{ 50 };
+    inline static constexpr std::string_view s_assetPackPath{ "data.pack" };
+
+    // Declared first so that it outlives the handles below.
+    std::unique_ptr<AssetLoader> m_assetLoader{};
 
     std::unique_ptr<Player> player{};
     std::unique_ptr<Ship> ship{};
     std::unique_ptr<Map> map{};
-    std::unique_ptr<Texture> coin{};
-    std::unique_ptr<Audio> mainAudio{};
+    AssetLoader::TextureHandle coin{};
+    AssetLoader::AudioHandle mainAudio{};
 
     Menu menu{};
 
@@ -61,6 +68,18 @@ public:
 )");
         Sprite::setOriginalSize(s_originalWindowSize);
 
+#ifndef __ANDROID__
+        // Built by the pack target; textures, sounds and the map then come from it.
+        if (std::error_code error{}; fs::exists(s_assetPackPath, error))
+            AssetRegistry::getInstance().mount(s_assetPackPath);
+#endif
+
+        // Decoded while the rest of the scene is set up.
+        m_assetLoader = std::make_unique<AssetLoader>();
+        coin = m_assetLoader->loadTexture("data/assets/coin.png");
+        mainAudio = m_assetLoader->loadAudio("data/audio/background.wav");
+        m_assetLoader->submit();
+
         ImGui::SetCurrentContext(getEngineInstance()->getImGuiContext());
         player =
             std::make_unique<Player>("data/assets/pirate/front/front_standing.png", Size{ 30, 30 });
@@ -70,164 +89,22 @@ public:
                                     "data/assets/bottle.png",
                                     "data/assets/treasure.png",
                                     "data/assets/xmark.png",
+                                    std::vector<fs::path>{ "data/assets/sand.png",
+                                                           "data/assets/sand_with_grass.png",
+                                                           "data/assets/grass.png",
+                                                           "data/assets/rocks.png",
+                                                           "data/assets/palm.png" },
                                     Size{ 50, 50 },
                                     Size{ 8000, 8000 });
-        coin = std::make_unique<Texture>();
-        mainAudio = std::make_unique<Audio>("data/audio/background.wav");
-        coin->load("data/assets/coin.png");
+        if (Config::generate_islands) {
+            auto builder{ map->createBuilder() };
+            IslandGenerator generator{ { .seed = Config::islands_seed, .featureSize = 20.0f } };
+            generator.generate(builder);
+            map->load(MapFile{ builder.build() });
+        }
+        else
+            map->load(MapFile{ "data/maps/islands.map" });
         map->generateBottles();
-        map->addIsland({ 400, 400 },
-                       { { "########SSSS###" },
-                         { "######SSBGGGS##" },
-                         { "##SSBBBGGGRGB##" },
-                         { "#SRBBRRGRRPGGS#" },
-                         { "##SBBGGGGRPPGS#" },
-                         { "###GPGBSSSGGBS#" },
-                         { "##SBB#####BRGS#" },
-                         { "##BBS#####BGGS#" },
-                         { "##BGG#####BGPS#" },
-                         { "#SBGGBB##SGRGS#" },
-                         { "#SGRGRB##SBGRS#" },
-                         { "##GGPGB##SBGS##" },
-                         { "##GGGGRS##SSS##" },
-                         { "##BBGBB########" },
-                         { "###SBS#########" } });
-
-        map->addIsland({ 1500, 0 },
-                       { { "###############" },
-                         { "#####S#########" },
-                         { "#####SS########" },
-                         { "#####RB##SS####" },
-                         { "#####SB##SB####" },
-                         { "#####SB##SBS###" },
-                         { "######S##SRS###" },
-                         { "#SS###S###SS#S#" },
-                         { "##SS#########S#" },
-                         { "##SS########SS#" },
-                         { "###SSS####SSSR#" },
-                         { "####SRSSSSBSS##" },
-                         { "####SBBRRBRS###" },
-                         { "######SRSS#####" },
-                         { "###############" } });
-
-        map->addIsland({ 0, 2000 },
-                       { { "###############" },
-                         { "###############" },
-                         { "###########SS##" },
-                         { "#SS#######SS###" },
-                         { "##B#####SBBB###" },
-                         { "##RS##SRBPB####" },
-                         { "##SGBSBBGG#####" },
-                         { "###GPGGPGB#####" },
-                         { "###SRGGGRR#####" },
-                         { "####GGPRGSS####" },
-                         { "####SS#RGPGS###" },
-                         { "########SGGS###" },
-                         { "#########RB####" },
-                         { "#########SS####" },
-                         { "###############" } });
-
-        map->addIsland({ 1600, 1500 },
-                       { { "###############" },
-                         { "#####SSSSSS####" },
-                         { "###SSBGBBRSS###" },
-                         { "###GGRPGGBBBS##" },
-                         { "#SGGGGGGGGPGSS#" },
-                         { "#SRGPGGGGGGGGS#" },
-                         { "##RGGBBRBGGPGS#" },
-                         { "##SGGGSSSSBBS##" },
-                         { "##SPPGS###SSS##" },
-                         { "##SBGGPS#######" },
-                         { "###SGGGS#######" },
-                         { "###SSGGG#######" },
-                         { "###SSBBBS######" },
-                         { "#####SBRBS#####" },
-                         { "#######SB######" } });
-
-        map->addIsland({ 2200, 700 },
-                       { { "#####SSSSS#####" },
-                         { "##SSBBGGGBSS###" },
-                         { "#SBBGPGGPGRBBS#" },
-                         { "#BBGGGGPGGGGGB#" },
-                         { "SRBGGGGGGGGPGGS" },
-                         { "SGGGPBGGRBGGGGB" },
-                         { "SGPGGBSSSSBGPGB" },
-                         { "SGGGS####SSBGGS" },
-                         { "#SGGS#####SBGGS" },
-                         { "#SSGS######BPG#" },
-                         { "##SBS#####SBSS#" },
-                         { "##SBBS####SGS##" },
-                         { "###SRS####SSS##" },
-                         { "####S######S###" },
-                         { "###############" } });
-
-        map->addIsland({ 3000, 1000 },
-                       { { "###############" },
-                         { "#########S#####" },
-                         { "#######SBBS####" },
-                         { "########SRGS###" },
-                         { "#####SS##BGGS##" },
-                         { "###SRSBS#SGBR##" },
-                         { "##SSBBBS##SSS##" },
-                         { "###SSS#####S###" },
-                         { "###############" },
-                         { "#######SSSS####" },
-                         { "##SSBBSGPBRSS##" },
-                         { "##SBRBGGBSSS###" },
-                         { "###SSSSBS######" },
-                         { "#######S#######" },
-                         { "###############" } });
-
-        map->addIsland({ 600, 3000 },
-                       { { "###############" },
-                         { "##SS###########" },
-                         { "#SBS###########" },
-                         { "#SGB###########" },
-                         { "##PGS##########" },
-                         { "#SBGS##########" },
-                         { "#SBPS##########" },
-                         { "#SGGRS#########" },
-                         { "##SGGGG########" },
-                         { "###BBGPGSSSSSS#" },
-                         { "###SSBRGGPRBS##" },
-                         { "####SSSSSSSS###" },
-                         { "###############" },
-                         { "###############" },
-                         { "###############" } });
-
-        map->addIsland({ 2000, 3500 },
-                       { { "###############" },
-                         { "############S##" },
-                         { "##########SRSS#" },
-                         { "#####SSRRRBBRS#" },
-                         { "#####SRRBBBRS##" },
-                         { "####SSBBBRS####" },
-                         { "#####SRRBR#####" },
-                         { "######SBBS#####" },
-                         { "#####SSRSS#####" },
-                         { "##SSSRBRS######" },
-                         { "#SBRRRBSS######" },
-                         { "#SSBRBBBS######" },
-                         { "####SSRRB######" },
-                         { "#####SSRRS#####" },
-                         { "###############" } });
-
-        map->addIsland({ 4000, 0 },
-                       { { "###############" },
-                         { "####SSRRS######" },
-                         { "###SSBBRBBS####" },
-                         { "####SRRRRBBB###" },
-                         { "#####SS#SSSBBS#" },
-                         { "##########BRBSS" },
-                         { "##SSSS####SRRSS" },
-                         { "##SBBRS##SSBBSS" },
-                         { "#SSRBBS#SSBBRS#" },
-                         { "##SBBRS#SBRBRR#" },
-                         { "##SBBRS##BBBBS#" },
-                         { "###BRBS###SSSS#" },
-                         { "####SSS########" },
-                         { "###############" },
-                         { "###############" } });
 
         Size size{ 50, 50 };
         m_islandSprites.try_emplace("sand", "data/assets/sand.png", size);
@@ -235,6 +112,8 @@ public:
         m_islandSprites.try_emplace("grass", "data/assets/grass.png", size);
         m_islandSprites.try_emplace("rock", "data/assets/rocks.png", size);
         m_islandSprites.try_emplace("palm", "data/assets/palm.png", size);
+        for (auto& [_, sprite] : m_islandSprites)
+            sprite.setLayer(Config::island_layer);
 
         m_charToIslandString['S'] = "sand";
         m_charToIslandString['B'] = "sand_with_grass";
@@ -244,7 +123,7 @@ public:
 
         Island::setIslandTiles(m_islandSprites);
         Island::setIslandPattern(m_charToIslandString);
-        mainAudio->play(true);
+        mainAudio.play(true);
 
         map->resizeUpdate();
         ship->resizeUpdate();
@@ -506,7 +385,10 @@ public:
         }
     }
 
+    // The engine orders draws by layer, so submission order does not matter here.
     void render() override {
+        m_assetLoader->update();
+
         if (menu.getActive()) {
             menu.render();
             return;
@@ -530,14 +412,13 @@ public:
                      ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoMove |
                          ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize);
 
-        auto tex = reinterpret_cast<ImTextureID>(coin->operator*());
         ImVec2 cursorPos{ ImGui::GetCursorPos() };
         ImGui::SetCursorPosY(cursorPos.y + 4);
         ImVec2 texSize(28, 28);
 
         ImGui::PushItemWidth(150);
 
-        ImGui::Image(tex, texSize);
+        ImGuiImage(coin.getTexture(), texSize);
         ImGui::SameLine();
 
         ImGui::SetCursorPosY(cursorPos.y);
@@ -546,6 +427,16 @@ public:
         ImGui::PopItemWidth();
         ImGui::End();
 
+        // The minimap is one quad of a texture with a texel per tile.
+        ImGui::SetNextWindowPos({ 0.0f, 0.0f });
+        ImGui::Begin("Minimap",
+                     nullptr,
+                     ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoMove |
+                         ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize |
+                         ImGuiWindowFlags_AlwaysAutoResize);
+        ImGuiImage(map->getMinimap(), { 160.0f, 160.0f });
+        ImGui::End();
+
 #ifdef __ANDROID__
         ImGui::SetNextWindowPos(
             ImVec2(ImGui::GetIO().DisplaySize.x - 110, ImGui::GetIO().DisplaySize.y - 385));
@@ -605,10 +496,12 @@ public:
             if (m_isOnShip) {
                 map->interact(*ship);
                 ship->update(timeElapsed);
+                map->explore(ship->getPosition());
             }
             else {
                 map->interact(*player);
                 player->update(timeElapsed);
+                map->explore(player->getPosition());
             }
 
             if (m_isOnShip)
@@ -0,0 +1,251 @@
+#include "island_generator.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <thread>
+#include <utility>
+
+// Splitmix64 finaliser, a cheap hash with well mixed bits.
+static std::uint64_t mix(std::uint64_t value) noexcept {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111eb;
+    value ^= value >> 31;
+    return value;
+}
+
+// Uniform value in [0, 1) for a lattice point.
+static float hashPoint(std::uint64_t seed, std::int64_t x, std::int64_t y) noexcept {
+    auto hash{ mix(seed ^ mix(static_cast<std::uint64_t>(x) * 0x9e3779b97f4a7c15 ^
+                              mix(static_cast<std::uint64_t>(y)))) };
+    return static_cast<float>(hash >> 40) / static_cast<float>(1 << 24);
+}
+
+static float valueNoise(std::uint64_t seed, float x, float y) noexcept {
+    auto floorX{ std::floor(x) };
+    auto floorY{ std::floor(y) };
+    auto latticeX{ static_cast<std::int64_t>(floorX) };
+    auto latticeY{ static_cast<std::int64_t>(floorY) };
+
+    auto smooth{ [](float t) { return t * t * (3.0f - 2.0f * t); } };
+    auto u{ smooth(x - floorX) };
+    auto v{ smooth(y - floorY) };
+
+    auto bottom{ std::lerp(hashPoint(seed, latticeX, latticeY),
+                           hashPoint(seed, latticeX + 1, latticeY),
+                           u) };
+    auto top{ std::lerp(hashPoint(seed, latticeX, latticeY + 1),
+                        hashPoint(seed, latticeX + 1, latticeY + 1),
+                        u) };
+    return std::lerp(bottom, top, v);
+}
+
+// Four octaves of value noise, each at twice the frequency and half the weight.
+static float fractalNoise(std::uint64_t seed, float x, float y) noexcept {
+    float sum{};
+    float weight{ 0.5f };
+    float weights{};
+
+    for (std::uint64_t octave{}; octave < 4; ++octave) {
+        sum += weight * valueNoise(mix(seed + octave), x, y);
+        weights += weight;
+        x *= 2.0f;
+        y *= 2.0f;
+        weight *= 0.5f;
+    }
+
+    return sum / weights;
+}
+
+// Calls process(firstRow, lastRow) for bands of rows on all cores and waits for them.
+template <typename Process>
+static void forEachBand(std::size_t rows, Process&& process) {
+    auto bandCount{ std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, rows) };
+    auto bandSize{ (rows + bandCount - 1) / bandCount };
+
+    std::vector<std::future<void>> bands{};
+    for (std::size_t first{}; first < rows; first += bandSize)
+        bands.push_back(
+            std::async(std::launch::async, process, first, std::min(first + bandSize, rows)));
+
+    for (auto& band : bands)
+        band.get();
+}
+
+IslandGenerator::IslandGenerator(Settings settings) : m_settings{ settings } {}
+
+std::size_t IslandGenerator::generate(MapBuilder& builder) const {
+    auto columns{ builder.getColumns() };
+    auto rows{ builder.getRows() };
+
+    auto land{ generateLand(columns, rows) };
+    smoothLand(land, columns, rows);
+    return addIslands(builder, dressLand(land, columns, rows), columns, rows);
+}
+
+std::vector<std::uint8_t> IslandGenerator::generateLand(std::size_t columns,
+                                                        std::size_t rows) const {
+    std::vector<std::uint8_t> land(columns * rows);
+    auto frequency{ 1.0f / m_settings.featureSize };
+    auto border{ static_cast<float>(m_settings.border) };
+
+    forEachBand(rows, [&](std::size_t firstRow, std::size_t lastRow) {
+        for (auto row{ firstRow }; row < lastRow; ++row)
+            for (std::size_t column{}; column < columns; ++column) {
+                auto value{ fractalNoise(m_settings.seed,
+                                         static_cast<float>(column) * frequency,
+                                         static_cast<float>(row) * frequency) };
+
+                // Land fades out over half a feature towards the border water.
+                auto edge{ static_cast<float>(
+                    std::min({ column, row, columns - 1 - column, rows - 1 - row })) };
+                value *= std::clamp(2.0f * (edge - border) / m_settings.featureSize, 0.0f, 1.0f);
+
+                land[row * columns + column] = value > m_settings.landThreshold;
+            }
+    });
+
+    return land;
+}
+
+void IslandGenerator::smoothLand(std::vector<std::uint8_t>& land,
+                                 std::size_t columns,
+                                 std::size_t rows) const {
+    std::vector<std::uint8_t> next(land.size());
+
+    // Tiles with mostly land around become land, mostly water becomes water.
+    for (std::size_t step{}; step < m_settings.smoothingSteps; ++step) {
+        forEachBand(rows, [&](std::size_t firstRow, std::size_t lastRow) {
+            for (auto row{ firstRow }; row < lastRow; ++row)
+                for (std::size_t column{}; column < columns; ++column) {
+                    int neighbours{};
+                    for (auto y{ row > 0 ? row - 1 : 0 }; y <= std::min(row + 1, rows - 1); ++y)
+                        for (auto x{ column > 0 ? column - 1 : 0 };
+                             x <= std::min(column + 1, columns - 1);
+                             ++x)
+                            neighbours += land[y * columns + x];
+
+                    auto index{ row * columns + column };
+                    neighbours -= land[index];
+                    next[index] = neighbours >= 5 ? 1 : neighbours <= 3 ? 0 : land[index];
+                }
+        });
+
+        land.swap(next);
+    }
+}
+
+std::vector<char> IslandGenerator::dressLand(const std::vector<std::uint8_t>& land,
+                                             std::size_t columns,
+                                             std::size_t rows) const {
+    std::vector<char> tiles(land.size(), '#');
+    auto rockSeed{ mix(m_settings.seed ^ 0x726f636b) };
+    auto palmSeed{ mix(m_settings.seed ^ 0x70616c6d) };
+    auto frequency{ 2.0f / m_settings.featureSize };
+
+    // Distance to the nearest water tile, up to two tiles.
+    auto getCoastDistance{ [&](std::size_t column, std::size_t row) {
+        for (std::size_t distance{ 1 }; distance <= 2; ++distance)
+            for (auto y{ row >= distance ? row - distance : 0 };
+                 y <= std::min(row + distance, rows - 1);
+                 ++y)
+                for (auto x{ column >= distance ? column - distance : 0 };
+                     x <= std::min(column + distance, columns - 1);
+                     ++x)
+                    if (!land[y * columns + x]) return distance;
+
+        return std::size_t{ 3 };
+    } };
+
+    forEachBand(rows, [&](std::size_t firstRow, std::size_t lastRow) {
+        for (auto row{ firstRow }; row < lastRow; ++row)
+            for (std::size_t column{}; column < columns; ++column) {
+                if (!land[row * columns + column]) continue;
+
+                auto& tile{ tiles[row * columns + column] };
+                switch (getCoastDistance(column, row)) {
+                case 1:
+                    tile = 'S';
+                    break;
+                case 2:
+                    tile = 'B';
+                    break;
+                default: {
+                    auto x{ static_cast<float>(column) * frequency };
+                    auto y{ static_cast<float>(row) * frequency };
+                    auto palm{ hashPoint(palmSeed,
+                                         static_cast<std::int64_t>(column),
+                                         static_cast<std::int64_t>(row)) };
+
+                    tile = fractalNoise(rockSeed, x, y) > 0.62f ? 'R' : palm < 0.08f ? 'P' : 'G';
+                }
+                }
+            }
+    });
+
+    return tiles;
+}
+
+std::size_t IslandGenerator::addIslands(MapBuilder& builder,
+                                        const std::vector<char>& tiles,
+                                        std::size_t columns,
+                                        std::size_t rows) {
+    // Connected land, four neighbours apart, is labelled in scan order.
+    constexpr std::uint32_t unlabelled{ 0 };
+    std::vector<std::uint32_t> labels(tiles.size(), unlabelled);
+    std::vector<std::size_t> stack{};
+    std::vector<std::size_t> island{};
+    std::uint32_t label{};
+
+    for (std::size_t start{}; start < tiles.size(); ++start) {
+        if (tiles[start] == '#' || labels[start] != unlabelled) continue;
+
+        ++label;
+        island.clear();
+        stack.push_back(start);
+        labels[start] = label;
+
+        auto firstColumn{ columns };
+        auto firstRow{ rows };
+        std::size_t lastColumn{};
+        std::size_t lastRow{};
+
+        while (!stack.empty()) {
+            auto index{ stack.back() };
+            stack.pop_back();
+            island.push_back(index);
+
+            auto column{ index % columns };
+            auto row{ index / columns };
+            firstColumn = std::min(firstColumn, column);
+            lastColumn = std::max(lastColumn, column);
+            firstRow = std::min(firstRow, row);
+            lastRow = std::max(lastRow, row);
+
+            auto visit{ [&](std::size_t neighbour) {
+                if (tiles[neighbour] != '#' && labels[neighbour] == unlabelled) {
+                    labels[neighbour] = label;
+                    stack.push_back(neighbour);
+                }
+            } };
+
+            if (column > 0) visit(index - 1);
+            if (column + 1 < columns) visit(index + 1);
+            if (row > 0) visit(index - columns);
+            if (row + 1 < rows) visit(index + columns);
+        }
+
+        // Patterns are written top row first; other islands in the box stay water.
+        auto width{ lastColumn - firstColumn + 1 };
+        auto height{ lastRow - firstRow + 1 };
+        std::vector<std::string> pattern(height, std::string(width, '#'));
+        for (auto index : island)
+            pattern[lastRow - index / columns][index % columns - firstColumn] = tiles[index];
+
+        builder.addIsland(firstColumn, firstRow, std::move(pattern));
+    }
+
+    return label;
+}
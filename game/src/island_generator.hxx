@@ -0,0 +1,54 @@
+#ifndef ENGINE_PREPARE_TO_GAME_ISLAND_GENERATOR_HXX
+#define ENGINE_PREPARE_TO_GAME_ISLAND_GENERATOR_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "map_builder.hxx"
+
+// Generates an archipelago over the whole grid of a MapBuilder: fractal value
+// noise above a threshold is land, a few cellular automaton steps smooth the
+// coasts, and land is then dressed by its distance to the water. Every step
+// processes bands of rows on all cores, and every tile depends only on the seed
+// and the previous step, so a seed always gives the same world. Each connected
+// piece of land becomes one island pattern in the alphabet of the map files.
+class IslandGenerator final
+{
+public:
+    struct Settings
+    {
+        std::uint64_t seed{};
+        // Noise above this value is land, higher values give less land.
+        float landThreshold{ 0.56f };
+        // Size in tiles of the largest noise features.
+        float featureSize{ 40.0f };
+        std::size_t smoothingSteps{ 4 };
+        // Water tiles kept along the edges of the world.
+        std::size_t border{ 4 };
+    };
+
+private:
+    Settings m_settings{};
+
+public:
+    explicit IslandGenerator(Settings settings);
+
+    // Adds the islands to the builder and returns how many there are.
+    std::size_t generate(MapBuilder& builder) const;
+
+private:
+    [[nodiscard]] std::vector<std::uint8_t> generateLand(std::size_t columns,
+                                                         std::size_t rows) const;
+    void smoothLand(std::vector<std::uint8_t>& land, std::size_t columns, std::size_t rows) const;
+    [[nodiscard]] std::vector<char> dressLand(const std::vector<std::uint8_t>& land,
+                                              std::size_t columns,
+                                              std::size_t rows) const;
+    [[nodiscard]] static std::size_t addIslands(MapBuilder& builder,
+                                                const std::vector<char>& tiles,
+                                                std::size_t columns,
+                                                std::size_t rows);
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_ISLAND_GENERATOR_HXX
@@ -1,9 +1,19 @@
 #include "map.hxx"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
+#include "config.hxx"
 #include "engine.hxx"
 
+using namespace std::literals;
+
 static int generateRandomNumber(int min, int max) {
     static std::seed_seq seed{
         std::random_device{}(),
@@ -16,11 +26,27 @@ static int generateRandomNumber(int min, int max) {
     return die(engine);
 }
 
+// Tile geometry is kept in normalized coordinates of the original 800x600 window.
+static std::vector<Vertex2> tileVertices(Size textureSize) {
+    auto halfWidth{ textureSize.width / 2.0f / (800.f * 0.5f) };
+    auto halfHeight{ textureSize.height / 2.0f / (600.f * 0.5f) };
+
+    return { { -halfWidth, halfHeight, 0.0f, 0.0f, 0 },
+             { halfWidth, halfHeight, 1.0f, 0.0f, 0 },
+             { halfWidth, -halfHeight, 1.0f, 1.0f, 0 },
+             { -halfWidth, -halfHeight, 0.0f, 1.0f, 0 } };
+}
+
+static Instance2 toInstance(Position position) {
+    return { .x = position.x / (800.f * 0.5f), .y = position.y / (600.f * 0.5f) };
+}
+
 Map::Map(const fs::path& waterTexturePath,
          const fs::path& airTexturePath,
          const fs::path& bottleTexturePath,
          const fs::path& treasureTexturePath,
          const fs::path& xMarkTexturePath,
+         const std::vector<fs::path>& islandTexturePaths,
          Size textureSize,
          Size mapSize)
     : m_waterSprite{ waterTexturePath, textureSize }
@@ -28,167 +54,65 @@ Map::Map(const fs::path& waterTexturePath,
     , m_bottle{ bottleTexturePath, textureSize }
     , m_treasure{ treasureTexturePath, xMarkTexturePath, textureSize }
     , m_textureSize{ textureSize }
-    , m_mapSize{ mapSize } {
-    float xOffset = -((800 / 2.0f) - (m_textureSize.width / 2.0f));
-    float yOffset = -((600 / 2.0f) - (m_textureSize.height / 2.0f));
-    for (std::ptrdiff_t h{}; h < m_mapSize.height / m_textureSize.height; ++h) {
-        for (std::ptrdiff_t w{}; w < m_mapSize.width / m_textureSize.width; ++w) {
-            float xPos = xOffset + (w * m_textureSize.width);
-            float yPos = yOffset + (h * m_textureSize.height);
-            m_waterPositions.push_back({ xPos, yPos });
-        }
-    }
-
-    std::vector<Vertex2> vertices{};
-    std::vector<std::uint32_t> indices{};
-    for (auto pos : m_waterPositions) {
-        auto leftXpos{ (pos.x + 400) - textureSize.width / 2.0f };
-        auto rightXpos{ (pos.x + 400) + textureSize.width / 2.0f };
-        auto topYpos{ (pos.y + 300) + textureSize.height / 2.0f };
-        auto bottomYpos{ (pos.y + 300) - textureSize.height / 2.0f };
-
-        auto normalizedXLeftPos{ (leftXpos / (800.f * 0.5f)) - 1.0f };
-        auto normalizedXRightPos{ (rightXpos / (800.f * 0.5f)) - 1.0f };
-        auto normalizedYTopPos{ (topYpos / (600.f * 0.5f)) - 1.0f };
-        auto normalizedYBottomPos{ (bottomYpos / (600.f * 0.5f)) - 1.0f };
-
-        Vertex2 v1{};
-        v1.x = normalizedXLeftPos;
-        v1.y = normalizedYTopPos;
-        v1.texX = 0.0;
-        v1.texY = 0.0;
-
-        vertices.push_back(v1);
-        auto firstIdx{ vertices.size() - 1 };
-
-        Vertex2 v2{};
-        v2.x = normalizedXRightPos;
-        v2.y = normalizedYTopPos;
-        v2.texX = 1.0;
-        v2.texY = 0.0;
-        vertices.push_back(v2);
-        auto secondIdx{ vertices.size() - 1 };
-
-        Vertex2 v3{};
-        v3.x = normalizedXRightPos;
-        v3.y = normalizedYBottomPos;
-        v3.texX = 1.0;
-        v3.texY = 1.0;
-        vertices.push_back(v3);
-        auto thirdIdx{ vertices.size() - 1 };
-
-        Vertex2 v4{};
-        v4.x = normalizedXLeftPos;
-        v4.y = normalizedYBottomPos;
-        v4.texX = 0.0;
-        v4.texY = 1.0;
-        vertices.push_back(v4);
-        auto fourthIdx{ vertices.size() - 1 };
-
-        indices.push_back(firstIdx);
-        indices.push_back(secondIdx);
-        indices.push_back(thirdIdx);
-
-        indices.push_back(firstIdx);
-        indices.push_back(thirdIdx);
-        indices.push_back(fourthIdx);
-    }
-
-    m_gridPtr = std::make_unique<VertexBuffer<Vertex2>>(vertices);
-    m_idxGridPtr = std::make_unique<IndexBuffer<std::uint32_t>>(indices);
-
-    std::vector<Vertex2> v2{};
-    std::vector<std::uint32_t> u32{};
-    for (auto& buffer : m_islandVertexBuffers)
-        buffer = std::make_unique<VertexBuffer<Vertex2>>(v2);
-
-    for (auto& buffer : m_islandIndexBuffers)
-        buffer = std::make_unique<IndexBuffer<std::uint32_t>>(u32);
+    , m_mapSize{ mapSize }
+    , m_pickups{ textureSize.width * 2.0f } {
+    m_gridOrigin = { -800 / 2.0f, -600 / 2.0f };
+    m_columns = static_cast<std::size_t>(m_mapSize.width / m_textureSize.width);
+    m_rows = static_cast<std::size_t>(m_mapSize.height / m_textureSize.height);
+
+    m_waterTileset = std::make_shared<const Tileset>(std::vector<fs::path>{ waterTexturePath });
+    // Ids follow the order of the island tile kinds, see toTileId.
+    m_islandTileset = std::make_shared<const Tileset>(islandTexturePaths);
+
+    m_tileVertexBuffer = std::make_unique<VertexBuffer<Vertex2>>(tileVertices(m_textureSize));
+    m_tileIndexBuffer = std::make_unique<IndexBuffer<std::uint16_t>>(
+        std::vector<std::uint16_t>{ 0, 1, 2, 0, 2, 3 });
+
+    m_bottleInstanceBuffer = std::make_unique<VertexBuffer<Instance2>>(std::vector<Instance2>{},
+                                                                       BufferUsage::dynamic_draw);
+    m_bottleMesh = std::make_unique<Mesh<Vertex2, std::uint16_t>>(
+        *m_tileVertexBuffer, *m_tileIndexBuffer, *m_bottleInstanceBuffer);
+
+    // The fog covers the whole grid in tile space, texture rows from the top.
+    auto columns{ static_cast<float>(m_columns) };
+    auto rows{ static_cast<float>(m_rows) };
+    m_fogVertexBuffer = std::make_unique<VertexBuffer<Vertex2>>(
+        std::vector<Vertex2>{ { 0.0f, rows, 0.0f, 0.0f, 0 },
+                              { columns, rows, 1.0f, 0.0f, 0 },
+                              { columns, 0.0f, 1.0f, 1.0f, 0 },
+                              { 0.0f, 0.0f, 0.0f, 1.0f, 0 } });
+    m_fogMesh =
+        std::make_unique<Mesh<Vertex2, std::uint16_t>>(*m_fogVertexBuffer, *m_tileIndexBuffer);
+}
 
-    m_bottleVertexBuffer = std::make_unique<VertexBuffer<Vertex2>>(v2);
-    m_bottleIndexBuffer = std::make_unique<IndexBuffer<std::uint32_t>>(u32);
+MapBuilder Map::createBuilder() const {
+    return { m_textureSize, m_columns, m_rows, m_gridOrigin };
 }
 
-void Map::addIsland(Position position, const std::vector<std::string>& pattern) {
-    Rectangle rectangle{ .xy = position,
-                         .wh = { m_textureSize.width * static_cast<float>(pattern.at(0).size()),
-                                 m_textureSize.height * static_cast<float>(pattern.size()) } };
-    m_islands.emplace_back(m_textureSize, rectangle, pattern);
-
-    for (const auto& pos : m_islands.back().getPositions()) {
-        auto found{ std::find(m_waterPositions.begin(), m_waterPositions.end(), pos.second) };
-        if (found != m_waterPositions.end()) m_waterPositions.erase(found);
-
-        auto leftXpos{ pos.second.x + 400 - m_textureSize.width / 2.0f };
-        auto rightXpos{ pos.second.x + 400 + m_textureSize.width / 2.0f };
-        auto topYpos{ pos.second.y + 300 + m_textureSize.height / 2.0f };
-        auto bottomYpos{ pos.second.y + 300 - m_textureSize.height / 2.0f };
-
-        auto normalizedXLeftPos{ (leftXpos / (800.f * 0.5f)) - 1.0f };
-        auto normalizedXRightPos{ (rightXpos / (800.f * 0.5f)) - 1.0f };
-        auto normalizedYTopPos{ (topYpos / (600.f * 0.5f)) - 1.0f };
-        auto normalizedYBottomPos{ (bottomYpos / (600.f * 0.5f)) - 1.0f };
-
-        Vertex2 v1{};
-        v1.x = normalizedXLeftPos;
-        v1.y = normalizedYTopPos;
-        v1.texX = 0.0;
-        v1.texY = 0.0;
-
-        Vertex2 v2{};
-        v2.x = normalizedXRightPos;
-        v2.y = normalizedYTopPos;
-        v2.texX = 1.0;
-        v2.texY = 0.0;
-
-        Vertex2 v3{};
-        v3.x = normalizedXRightPos;
-        v3.y = normalizedYBottomPos;
-        v3.texX = 1.0;
-        v3.texY = 1.0;
-
-        Vertex2 v4{};
-        v4.x = normalizedXLeftPos;
-        v4.y = normalizedYBottomPos;
-        v4.texX = 0.0;
-        v4.texY = 1.0;
-
-        std::size_t idx{};
-        switch (pos.first) {
-        case 'S':
-            idx = 0;
-            break;
-        case 'B':
-            idx = 1;
-            break;
-        case 'G':
-            idx = 2;
-            break;
-        case 'R':
-            idx = 3;
-            break;
-        case 'P':
-            idx = 4;
-            break;
-        }
-        auto& vBuffer{ m_islandVertexBuffers.at(idx) };
-        auto& iBuffer{ m_islandIndexBuffers.at(idx) };
-        auto size{ static_cast<std::uint32_t>(vBuffer->size()) };
+void Map::load(MapFile&& file) {
+    const auto& header{ file.getHeader() };
+    if (header.columns != m_columns || header.rows != m_rows || file.getTileSize() != m_textureSize)
+        throw std::runtime_error{ "Error : Map::load : map file does not match the map grid"s };
 
-        std::vector<Vertex2> vert{ v1, v2, v3, v4 };
-        vBuffer->addData(vert);
+    // The streamer, the grid and the exploration read the old file until it is gone.
+    m_streamer.reset();
+    m_collisionGrid.reset();
+    m_exploration.reset();
 
-        std::vector<std::uint32_t> indices{ size + 0, size + 1, size + 2,
-                                            size + 0, size + 2, size + 3 };
-        iBuffer->addData(indices);
-    }
-}
+    m_mapFile = std::move(file);
+    m_collisionGrid.emplace(*m_mapFile);
+    m_exploration.emplace(*m_mapFile);
+    m_streamer = std::make_unique<WorldStreamer>(
+        *m_mapFile, m_waterTileset, m_islandTileset, s_chunkSize, s_chunkMemoryBudget);
 
-const std::vector<Position>& Map::getWaterPositions() const noexcept { return m_waterPositions; }
+    m_isCacheValid = false;
+}
 
 void Map::resizeUpdate() {
-    for (auto& island : m_islands)
-        island.resizeUpdate();
+    if (m_streamer)
+        for (auto& [_, chunk] : m_streamer->getChunks())
+            for (auto& island : chunk.islandList)
+                island.resizeUpdate();
 
     m_bottle.resizeUpdate();
     m_treasure.resizeUpdate();
@@ -197,78 +121,169 @@ void Map::resizeUpdate() {
     m_waterSprite.checkAspect({ 800, 600 });
     m_airSprite.updateWindowSize();
     m_airSprite.checkAspect({ 800, 600 });
+
+    m_isCacheValid = false;
 }
 
 void Map::render(const View& view) {
-    for (std::size_t i{}; i < 5; ++i) {
-        char isl{};
-        switch (i) {
-        case 0:
-            isl = 'S';
-            break;
-        case 1:
-            isl = 'B';
-            break;
-        case 2:
-            isl = 'G';
-            break;
-        case 3:
-            isl = 'R';
-            break;
-        case 4:
-            isl = 'P';
-            break;
-        }
-
-        auto& sprite{ Island::getIslandTiles()->at(Island::getChatToIsland()->at(isl)) };
-        sprite.setPosition({ 0, 0 });
-
-        getEngineInstance()->render(*m_islandVertexBuffers.at(i),
-                                    *m_islandIndexBuffers.at(i),
-                                    sprite.getTexture(),
-                                    sprite.getResultMatrix(),
-                                    view);
+    updateChunks(view);
+    updateLayerCache(view);
+
+    // The cache quad spans the clip space of the cache view, mapped back through it.
+    getEngineInstance()->render(*m_cacheMesh,
+                                m_layerCache->getTexture(),
+                                glm::inverse(m_cacheViewMatrix),
+                                view,
+                                Config::water_layer,
+                                BlendMode::opaque);
+
+    if (m_exploration) {
+        m_exploration->upload();
+
+        m_waterSprite.setPosition({ 0, 0 });
+        getEngineInstance()->render(*m_fogMesh,
+                                    m_exploration->getFog(),
+                                    m_waterSprite.getTransformMatrix() * getTileMatrix(),
+                                    view,
+                                    Config::fog_layer,
+                                    BlendMode::alpha);
     }
 
     m_bottle.setPosition({ 0, 0 });
-    getEngineInstance()->render(*m_bottleVertexBuffer,
-                                *m_bottleIndexBuffer,
+    getEngineInstance()->render(*m_bottleMesh,
                                 m_bottle.getSprite().getTexture(),
-                                m_bottle.getSprite().getResultMatrix(),
-                                view);
+                                m_bottle.getSprite().getTransformMatrix(),
+                                view,
+                                Config::bottle_layer,
+                                BlendMode::alpha);
+}
+
+void Map::updateChunks(const View& view) {
+    if (!m_streamer) return;
+
+    // Chunks are streamed for the area the layer cache covers.
+    auto area{ view.getVisibleRectangle() };
+    area.xy.x -= area.wh.width * (s_cacheSize - 1.0f) / 2.0f;
+    area.xy.y -= area.wh.height * (s_cacheSize - 1.0f) / 2.0f;
+    area.wh.width *= s_cacheSize;
+    area.wh.height *= s_cacheSize;
+
+    if (m_streamer->update(area)) m_isCacheValid = false;
+}
+
+void Map::updateLayerCache(const View& view) {
+    auto windowSize{ getEngineInstance()->getWindowSize() };
+    auto width{ static_cast<std::size_t>(static_cast<float>(windowSize.width) * s_cacheSize) };
+    auto height{ static_cast<std::size_t>(static_cast<float>(windowSize.height) * s_cacheSize) };
+
+    if (!m_layerCache) {
+        m_layerCache = std::make_unique<Framebuffer>(width, height);
+
+        // Rows of the cache texture go from bottom to top.
+        m_cacheVertexBuffer = std::make_unique<VertexBuffer<Vertex2>>(
+            std::vector<Vertex2>{ { -1.0f, 1.0f, 0.0f, 1.0f, 0 },
+                                  { 1.0f, 1.0f, 1.0f, 1.0f, 0 },
+                                  { 1.0f, -1.0f, 1.0f, 0.0f, 0 },
+                                  { -1.0f, -1.0f, 0.0f, 0.0f, 0 } });
+        m_cacheMesh = std::make_unique<Mesh<Vertex2, std::uint16_t>>(*m_cacheVertexBuffer,
+                                                                     *m_tileIndexBuffer);
+    }
+    else if (width != m_layerCache->getWidth() || height != m_layerCache->getHeight()) {
+        m_layerCache->resize(width, height);
+        m_isCacheValid = false;
+    }
+
+    if (m_isCacheValid && view.getScale() == m_cacheScale && isInLayerCache(view)) return;
+
+    // The cache view sees s_cacheSize times the area of the screen around the view.
+    View cacheView{};
+    cacheView.setPosition(view.getPosition());
+    cacheView.setScale(view.getScale() / s_cacheSize);
 
+    getEngineInstance()->beginRenderTarget(*m_layerCache);
+    renderStaticLayers(cacheView);
+    getEngineInstance()->endRenderTarget();
+
+    m_cacheViewMatrix = cacheView.getViewMatrix();
+    m_cacheScale = view.getScale();
+    m_isCacheValid = true;
+}
+
+bool Map::isInLayerCache(const View& view) const {
+    // Corners of the screen in the clip space of the cache view.
+    auto screenToCache{ m_cacheViewMatrix * glm::inverse(view.getViewMatrix()) };
+    for (float x : { -1.0f, 1.0f })
+        for (float y : { -1.0f, 1.0f }) {
+            auto corner{ screenToCache * glm::vec3{ x, y, 1.0f } };
+            if (std::abs(corner.x) > 1.0f || std::abs(corner.y) > 1.0f) return false;
+        }
+
+    return true;
+}
+
+glm::mat3 Map::getTileMatrix() const noexcept {
+    glm::mat3 tileMatrix{ 1.0f };
+    tileMatrix[0][0] = m_textureSize.width / (800.f * 0.5f);
+    tileMatrix[1][1] = m_textureSize.height / (600.f * 0.5f);
+    tileMatrix[2][0] = m_gridOrigin.x / (800.f * 0.5f);
+    tileMatrix[2][1] = m_gridOrigin.y / (600.f * 0.5f);
+    return tileMatrix;
+}
+
+void Map::renderStaticLayers(const View& view) {
     m_waterSprite.setPosition({ 0, 0 });
-    getEngineInstance()->render(*m_gridPtr,
-                                *m_idxGridPtr,
-                                m_waterSprite.getTexture(),
-                                m_waterSprite.getResultMatrix(),
-                                view);
+    auto matrix{ m_waterSprite.getTransformMatrix() * getTileMatrix() };
+    auto visibleRectangle{ view.getVisibleRectangle() };
+
+    for (const auto& [_, chunk] : m_streamer->getChunks()) {
+        Rectangle chunkRectangle{
+            .xy = { m_gridOrigin.x + m_textureSize.width * static_cast<float>(chunk.firstColumn),
+                    m_gridOrigin.y + m_textureSize.height * static_cast<float>(chunk.firstRow) },
+            .wh = { m_textureSize.width * static_cast<float>(chunk.water->getColumns()),
+                    m_textureSize.height * static_cast<float>(chunk.water->getRows()) }
+        };
+        if (!intersect(chunkRectangle, visibleRectangle)) continue;
+
+        // Tile space of the chunk starts at its first tile.
+        auto chunkMatrix{ matrix };
+        chunkMatrix[2] = matrix * glm::vec3{ static_cast<float>(chunk.firstColumn),
+                                             static_cast<float>(chunk.firstRow),
+                                             1.0f };
+
+        getEngineInstance()->render(
+            *chunk.islands, chunkMatrix, view, Config::island_layer, BlendMode::alpha);
+        getEngineInstance()->render(
+            *chunk.water, chunkMatrix, view, Config::water_layer, BlendMode::opaque);
+    }
 }
 
 Sprite& Map::getWaterSprite() noexcept { return m_waterSprite; }
-Island& Map::getIsland(std::size_t id) noexcept { return m_islands.at(id); }
+
+void Map::explore(Position position) {
+    if (m_exploration) m_exploration->explore(position, s_exploreRadius);
+}
+
+Texture& Map::getMinimap() {
+    if (!m_exploration) throw std::runtime_error{ "Error : Map::getMinimap : no map is loaded"s };
+
+    return m_exploration->getMinimap();
+}
 
 void Map::interact(Ship& ship) {
-    if (!ship.isInteract())
-        for (auto& island : m_islands) {
-            island.interact(ship);
-            if (ship.isInteract()) {
-                m_interactIsland = &island;
-                break;
-            }
-        }
+    // Running onto land stops the ship next to the island.
+    if (!ship.isInteract() && m_collisionGrid && m_collisionGrid->isSolid(ship.getPosition()))
+        ship.forceStop();
 
     if (!ship.getPlayer().hasBottle()) {
-        for (std::size_t i{}; i < m_bottlePositions.size(); ++i) {
-            m_bottle.setPosition(m_bottlePositions[i]);
-            if (intersect(m_bottle.getSprite(), ship.getSprite())) {
-                generateTreasure();
-                ship.getPlayer().setBottle(true);
-                m_isTreasureUnearthed = false;
-                m_bottlePositions.erase(m_bottlePositions.begin() + i);
-                generateBottles();
-                break;
-            }
+        m_pickupHits.clear();
+        m_pickups.query(ship.getSprite().getRectangle(), m_pickupHits);
+
+        if (!m_pickupHits.empty()) {
+            generateTreasure();
+            ship.getPlayer().setBottle(true);
+            m_isTreasureUnearthed = false;
+            removeBottle(static_cast<std::size_t>(m_pickups.getUserData(m_pickupHits.front())));
+            generateBottles();
         }
     }
 
@@ -283,7 +298,8 @@ void Map::interact(Ship& ship) {
 }
 
 void Map::interact(Player& player) {
-    m_interactIsland->interact(player);
+    // The player can't walk into the water.
+    if (m_collisionGrid && !m_collisionGrid->isSolid(player.getPosition())) player.forceStop();
 
     if (player.isDigging()) {
         auto is{ intersect(m_treasure.getTreasureSprite(), player.getSprite()) };
@@ -304,9 +320,12 @@ void Map::interact(Player& player) {
 }
 
 void Map::generateBottles() {
+    if (!m_mapFile || m_mapFile->getWaterSpawns().empty()) return;
+
+    auto waterSpawns{ m_mapFile->getWaterSpawns() };
     while (m_countOfBottles < s_maxCountOfBottles) {
-        auto randomPos{ generateRandomNumber(0, static_cast<int>(m_waterPositions.size()) - 1) };
-        m_bottlePositions.emplace_back(m_waterPositions.at(randomPos));
+        auto randomPos{ generateRandomNumber(0, static_cast<int>(waterSpawns.size()) - 1) };
+        addBottle(m_mapFile->getTileCenter(waterSpawns[randomPos]));
         ++m_countOfBottles;
     }
 
@@ -314,72 +333,54 @@ void Map::generateBottles() {
 }
 
 void Map::generateTreasure() {
-    auto rndIsland{ generateRandomNumber(0, static_cast<int>(m_islands.size()) - 1) };
-    auto rndPos{ generateRandomNumber(
-        0, static_cast<int>(m_islands[rndIsland].getPositions().size()) - 1) };
-    auto pos{ m_islands[rndIsland].getPositions().at(rndPos).second };
-    m_treasure.setPosition(pos);
+    // Any island of the world, resident or not, so it is picked from the file.
+    if (!m_mapFile || m_mapFile->getIslands().empty()) return;
+
+    auto islands{ m_mapFile->getIslands() };
+    const auto& island{ islands[generateRandomNumber(0, static_cast<int>(islands.size()) - 1)] };
+    if (island.landSpawnCount == 0) return;
+
+    auto rndPos{ generateRandomNumber(0, static_cast<int>(island.landSpawnCount) - 1) };
+    auto tile{ m_mapFile->getLandSpawns()[island.firstLandSpawn + rndPos] };
+    m_treasure.setPosition(m_mapFile->getTileCenter(tile));
 }
 
 Treasure& Map::getTreasure() noexcept { return m_treasure; }
 
 bool Map::isTreasureUnearthed() const noexcept { return m_isTreasureUnearthed; }
 
+void Map::addBottle(Position position) {
+    Rectangle bounds{ .xy = { position.x - m_textureSize.width / 2.0f,
+                              position.y - m_textureSize.height / 2.0f },
+                      .wh = m_textureSize };
+
+    m_bottleHandles.push_back(m_pickups.insert(bounds, m_bottlePositions.size()));
+    m_bottlePositions.push_back(position);
+}
+
+void Map::removeBottle(std::size_t index) {
+    m_pickups.remove(m_bottleHandles.at(index));
+
+    // The last bottle takes the place of the removed one.
+    m_bottlePositions[index] = m_bottlePositions.back();
+    m_bottlePositions.pop_back();
+    m_bottleHandles[index] = m_bottleHandles.back();
+    m_bottleHandles.pop_back();
+
+    if (index < m_bottleHandles.size()) m_pickups.setUserData(m_bottleHandles[index], index);
+}
+
 void Map::updateBottlePositions() {
-    std::vector<Vertex2> vertices{};
-    std::vector<std::uint32_t> indices{};
-    for (auto pos : m_bottlePositions) {
-        auto leftXpos{ (pos.x + 400) - m_textureSize.width / 2.0f };
-        auto rightXpos{ (pos.x + 400) + m_textureSize.width / 2.0f };
-        auto topYpos{ (pos.y + 300) + m_textureSize.height / 2.0f };
-        auto bottomYpos{ (pos.y + 300) - m_textureSize.height / 2.0f };
-
-        auto normalizedXLeftPos{ (leftXpos / (800.f * 0.5f)) - 1.0f };
-        auto normalizedXRightPos{ (rightXpos / (800.f * 0.5f)) - 1.0f };
-        auto normalizedYTopPos{ (topYpos / (600.f * 0.5f)) - 1.0f };
-        auto normalizedYBottomPos{ (bottomYpos / (600.f * 0.5f)) - 1.0f };
-
-        Vertex2 v1{};
-        v1.x = normalizedXLeftPos;
-        v1.y = normalizedYTopPos;
-        v1.texX = 0.0;
-        v1.texY = 0.0;
-
-        vertices.push_back(v1);
-        auto firstIdx{ vertices.size() - 1 };
-
-        Vertex2 v2{};
-        v2.x = normalizedXRightPos;
-        v2.y = normalizedYTopPos;
-        v2.texX = 1.0;
-        v2.texY = 0.0;
-        vertices.push_back(v2);
-        auto secondIdx{ vertices.size() - 1 };
-
-        Vertex2 v3{};
-        v3.x = normalizedXRightPos;
-        v3.y = normalizedYBottomPos;
-        v3.texX = 1.0;
-        v3.texY = 1.0;
-        vertices.push_back(v3);
-        auto thirdIdx{ vertices.size() - 1 };
-
-        Vertex2 v4{};
-        v4.x = normalizedXLeftPos;
-        v4.y = normalizedYBottomPos;
-        v4.texX = 0.0;
-        v4.texY = 1.0;
-        vertices.push_back(v4);
-        auto fourthIdx{ vertices.size() - 1 };
-
-        indices.push_back(firstIdx);
-        indices.push_back(secondIdx);
-        indices.push_back(thirdIdx);
-
-        indices.push_back(firstIdx);
-        indices.push_back(thirdIdx);
-        indices.push_back(fourthIdx);
-    }
-    m_bottleVertexBuffer->updateData(std::move(vertices));
-    m_bottleIndexBuffer->updateData(std::move(indices));
+    std::vector<Instance2> instances{};
+    instances.reserve(m_bottlePositions.size());
+    std::ranges::transform(m_bottlePositions, std::back_inserter(instances), toInstance);
+
+    // Bottles are appended and a picked up one is replaced by the last, so the
+    // upload starts at the first changed bottle.
+    auto first{ static_cast<std::size_t>(
+        std::ranges::mismatch(instances, m_bottleInstanceBuffer->getData()).in1 -
+        instances.begin()) };
+
+    m_bottleInstanceBuffer->resize(first);
+    m_bottleInstanceBuffer->updateData(first, std::span{ instances }.subspan(first));
 }
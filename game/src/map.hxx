@@ -1,18 +1,31 @@
 #ifndef ENGINE_PREPARE_TO_GAME_MAP_HXX
 #define ENGINE_PREPARE_TO_GAME_MAP_HXX
 
-#include <array>
+#include <cstddef>
 #include <filesystem>
+#include <framebuffer.hxx>
+#include <glm/glm.hpp>
 #include <memory>
+#include <mesh.hxx>
+#include <optional>
+#include <spatial_hash.hxx>
 #include <sprite.hxx>
+#include <tilemap.hxx>
+#include <tileset.hxx>
+#include <utility>
 #include <vector>
 #include <view.hxx>
 
 #include "bottle.hxx"
+#include "collision_grid.hxx"
+#include "exploration.hxx"
 #include "island.hxx"
+#include "map_builder.hxx"
+#include "map_file.hxx"
 #include "player.hxx"
 #include "ship.hxx"
 #include "treasure.hxx"
+#include "world_streamer.hxx"
 
 namespace fs = std::filesystem;
 
@@ -30,37 +43,69 @@ private:
 
     Rectangle m_shipRectangle{};
 
-    std::vector<Island> m_islands{};
-    std::vector<Position> m_waterPositions{};
+    std::optional<MapFile> m_mapFile{};
+    // Land of the whole world for ship and player collisions.
+    std::optional<CollisionGrid> m_collisionGrid{};
+    // Tiles seen around the explorer, drawn as fog over the world and as the minimap.
+    std::optional<Exploration> m_exploration{};
+    inline static constexpr std::size_t s_exploreRadius{ 5 };
+    std::unique_ptr<VertexBuffer<Vertex2>> m_fogVertexBuffer{};
+    std::unique_ptr<Mesh<Vertex2, std::uint16_t>> m_fogMesh{};
     std::vector<Position> m_airPositions{};
     std::vector<Position> m_bottlePositions{};
-
-    std::unique_ptr<VertexBuffer<Vertex2>> m_gridPtr{};
-    std::unique_ptr<IndexBuffer<std::uint32_t>> m_idxGridPtr{};
-
-    std::array<std::unique_ptr<VertexBuffer<Vertex2>>, 5> m_islandVertexBuffers{};
-    std::array<std::unique_ptr<IndexBuffer<std::uint32_t>>, 5> m_islandIndexBuffers{};
-
-    std::unique_ptr<VertexBuffer<Vertex2>> m_bottleVertexBuffer{};
-    std::unique_ptr<IndexBuffer<std::uint32_t>> m_bottleIndexBuffer{};
+    // Bottles in a broadphase by their index in m_bottlePositions, cells of two tiles.
+    SpatialHash m_pickups;
+    std::vector<SpatialHash::Handle> m_bottleHandles{};
+    std::vector<SpatialHash::Handle> m_pickupHits{};
+
+    // World position of the corner of tile (0, 0) of the tilemaps.
+    Position m_gridOrigin{};
+    std::size_t m_columns{};
+    std::size_t m_rows{};
+
+    // Water and islands are tilemaps of the chunks streamed in around the view,
+    // with one byte per tile, each drawn as a single quad.
+    inline static constexpr std::size_t s_chunkSize{ 32 };
+    inline static constexpr std::size_t s_chunkMemoryBudget{ 8 * 1024 * 1024 };
+    std::shared_ptr<const Tileset> m_waterTileset{};
+    std::shared_ptr<const Tileset> m_islandTileset{};
+    std::unique_ptr<WorldStreamer> m_streamer{};
+
+    // Water and islands never move, so they are drawn into a texture covering
+    // s_cacheSize times the screen around the view and composited with one quad
+    // until the view leaves that area or changes its scale.
+    inline static constexpr float s_cacheSize{ 2.0f };
+    std::unique_ptr<Framebuffer> m_layerCache{};
+    std::unique_ptr<VertexBuffer<Vertex2>> m_cacheVertexBuffer{};
+    std::unique_ptr<Mesh<Vertex2, std::uint16_t>> m_cacheMesh{};
+    glm::mat3 m_cacheViewMatrix{ 1.0f };
+    float m_cacheScale{};
+    bool m_isCacheValid{};
+
+    // One tile quad, bottles are drawn as instances of it.
+    std::unique_ptr<VertexBuffer<Vertex2>> m_tileVertexBuffer{};
+    std::unique_ptr<IndexBuffer<std::uint16_t>> m_tileIndexBuffer{};
+    std::unique_ptr<VertexBuffer<Instance2>> m_bottleInstanceBuffer{};
+    std::unique_ptr<Mesh<Vertex2, std::uint16_t>> m_bottleMesh{};
 
     inline static constexpr int s_maxCountOfBottles{ 50 };
     int m_countOfBottles{};
     bool m_isTreasureUnearthed{};
 
-    Island* m_interactIsland{};
-
 public:
     Map(const fs::path& waterTexturePath,
         const fs::path& airTexturePath,
         const fs::path& bottleTexturePath,
         const fs::path& treasureTexturePath,
         const fs::path& xMarkTexturePath,
+        const std::vector<fs::path>& islandTexturePaths,
         Size textureSize,
         Size mapSize);
 
-    void addIsland(Position position, const std::vector<std::string>& pattern);
-    [[nodiscard]] Island& getIsland(std::size_t id) noexcept;
+    // Builder on the tile grid of this map, for maps made in code.
+    [[nodiscard]] MapBuilder createBuilder() const;
+    // Replaces all islands; the map keeps the file to stream its chunks and read its spawn tables.
+    void load(MapFile&& file);
     void resizeUpdate();
     void render(const View& view);
 
@@ -70,12 +115,22 @@ public:
     void generateBottles();
     void generateTreasure();
 
-    [[nodiscard]] const std::vector<Position>& getWaterPositions() const noexcept;
+    void explore(Position position);
+    [[nodiscard]] Texture& getMinimap();
+
     [[nodiscard]] Sprite& getWaterSprite() noexcept;
     [[nodiscard]] bool isTreasureUnearthed() const noexcept;
     Treasure& getTreasure() noexcept;
 
 private:
+    // Tile space to the normalized coordinates of the original 800x600 window.
+    [[nodiscard]] glm::mat3 getTileMatrix() const noexcept;
+    void updateChunks(const View& view);
+    void updateLayerCache(const View& view);
+    [[nodiscard]] bool isInLayerCache(const View& view) const;
+    void renderStaticLayers(const View& view);
+    void addBottle(Position position);
+    void removeBottle(std::size_t index);
     void updateBottlePositions();
 };
 
@@ -0,0 +1,171 @@
+#include "map_builder.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::literals;
+
+static_assert(std::endian::native == std::endian::little, "map files are little-endian");
+
+static std::size_t alignSection(std::size_t offset) noexcept {
+    return (offset + 7) & ~std::size_t{ 7 };
+}
+
+template <typename T>
+static void writeSection(std::vector<std::byte>& image,
+                         std::size_t offset,
+                         const std::vector<T>& data) {
+    if (!data.empty()) std::memcpy(image.data() + offset, data.data(), data.size() * sizeof(T));
+}
+
+MapBuilder::MapBuilder(Size tileSize, std::size_t columns, std::size_t rows, Position gridOrigin)
+    : m_tileSize{ tileSize }, m_columns{ columns }, m_rows{ rows }, m_gridOrigin{ gridOrigin } {
+    if (m_columns == 0 || m_rows == 0)
+        throw std::runtime_error{ "Error : MapBuilder::MapBuilder : empty grid"s };
+}
+
+void MapBuilder::addIsland(Position position, std::vector<std::string> pattern) {
+    if (pattern.empty() || pattern.front().empty())
+        throw std::runtime_error{ "Error : MapBuilder::addIsland : empty pattern"s };
+
+    for (const auto& row : pattern)
+        if (row.size() != pattern.front().size())
+            throw std::runtime_error{
+                "Error : MapBuilder::addIsland : pattern rows differ in size"s
+            };
+
+    m_patterns.push_back({ position, std::move(pattern) });
+}
+
+void MapBuilder::addIsland(std::size_t column, std::size_t row, std::vector<std::string> pattern) {
+    // The tile centre maps back to the tile whatever the rounding.
+    addIsland({ m_gridOrigin.x + m_tileSize.width * (static_cast<float>(column) + 0.5f),
+                m_gridOrigin.y + m_tileSize.height * (static_cast<float>(row) + 0.5f) },
+              std::move(pattern));
+}
+
+std::vector<std::byte> MapBuilder::build() const {
+    auto threadCount{ std::clamp<std::size_t>(
+        std::thread::hardware_concurrency(), 1, std::max<std::size_t>(m_patterns.size(), 1)) };
+    auto groupSize{ (m_patterns.size() + threadCount - 1) / threadCount };
+
+    std::vector<std::future<std::vector<IslandTiles>>> groups{};
+    for (std::size_t first{}; first < m_patterns.size(); first += groupSize)
+        groups.push_back(std::async(std::launch::async,
+                                    &MapBuilder::parseIslands,
+                                    this,
+                                    first,
+                                    std::min(first + groupSize, m_patterns.size())));
+
+    std::vector<std::uint8_t> tiles(m_columns * m_rows, map_file_water);
+    std::vector<MapFileIsland> islands{};
+    std::vector<std::uint32_t> landSpawns{};
+    islands.reserve(m_patterns.size());
+
+    // Groups are joined in order, so later islands still cover earlier ones.
+    for (auto& group : groups)
+        for (auto& island : group.get()) {
+            island.bounds.firstLandSpawn = static_cast<std::uint32_t>(landSpawns.size());
+            island.bounds.landSpawnCount = static_cast<std::uint32_t>(island.tiles.size());
+            islands.push_back(island.bounds);
+
+            for (auto [index, id] : island.tiles) {
+                tiles[index] = id;
+                landSpawns.push_back(index);
+            }
+        }
+
+    auto stride{ getCollisionStride(m_columns) };
+    std::vector<std::uint64_t> collision(stride * m_rows);
+    std::vector<std::uint32_t> waterSpawns{};
+    waterSpawns.reserve(tiles.size());
+
+    for (std::size_t row{}; row < m_rows; ++row)
+        for (std::size_t column{}; column < m_columns; ++column) {
+            auto index{ row * m_columns + column };
+            if (tiles[index] == map_file_water)
+                waterSpawns.push_back(static_cast<std::uint32_t>(index));
+            else
+                collision[row * stride + column / 64] |= std::uint64_t{ 1 } << column % 64;
+        }
+
+    MapFileHeader header{ .magic = map_file_magic,
+                          .version = map_file_version,
+                          .columns = static_cast<std::uint32_t>(m_columns),
+                          .rows = static_cast<std::uint32_t>(m_rows),
+                          .tileWidth = m_tileSize.width,
+                          .tileHeight = m_tileSize.height,
+                          .originX = m_gridOrigin.x,
+                          .originY = m_gridOrigin.y,
+                          .islandCount = static_cast<std::uint32_t>(islands.size()),
+                          .waterSpawnCount = static_cast<std::uint32_t>(waterSpawns.size()),
+                          .landSpawnCount = static_cast<std::uint32_t>(landSpawns.size()) };
+
+    header.tilesOffset = alignSection(sizeof(MapFileHeader));
+    header.collisionOffset = alignSection(header.tilesOffset + tiles.size());
+    header.islandsOffset =
+        alignSection(header.collisionOffset + collision.size() * sizeof(std::uint64_t));
+    header.waterSpawnsOffset =
+        alignSection(header.islandsOffset + islands.size() * sizeof(MapFileIsland));
+    header.landSpawnsOffset =
+        alignSection(header.waterSpawnsOffset + waterSpawns.size() * sizeof(std::uint32_t));
+
+    std::vector<std::byte> image(header.landSpawnsOffset +
+                                 landSpawns.size() * sizeof(std::uint32_t));
+    std::memcpy(image.data(), &header, sizeof(header));
+    writeSection(image, header.tilesOffset, tiles);
+    writeSection(image, header.collisionOffset, collision);
+    writeSection(image, header.islandsOffset, islands);
+    writeSection(image, header.waterSpawnsOffset, waterSpawns);
+    writeSection(image, header.landSpawnsOffset, landSpawns);
+
+    return image;
+}
+
+std::size_t MapBuilder::getColumns() const noexcept { return m_columns; }
+
+std::size_t MapBuilder::getRows() const noexcept { return m_rows; }
+
+std::vector<MapBuilder::IslandTiles> MapBuilder::parseIslands(std::size_t first,
+                                                              std::size_t last) const {
+    std::vector<IslandTiles> islands{};
+    islands.reserve(last - first);
+
+    for (auto index{ first }; index < last; ++index) {
+        const auto& [position, pattern]{ m_patterns[index] };
+
+        auto column{ std::floor((position.x - m_gridOrigin.x) / m_tileSize.width) };
+        auto row{ std::floor((position.y - m_gridOrigin.y) / m_tileSize.height) };
+        auto width{ pattern.front().size() };
+        auto height{ pattern.size() };
+
+        if (column < 0 || row < 0 ||
+            column + static_cast<float>(width) > static_cast<float>(m_columns) ||
+            row + static_cast<float>(height) > static_cast<float>(m_rows))
+            throw std::runtime_error{ "Error : MapBuilder::build : island is out of the map"s };
+
+        auto& island{ islands.emplace_back() };
+        island.bounds = { .firstColumn = static_cast<std::uint32_t>(column),
+                          .firstRow = static_cast<std::uint32_t>(row),
+                          .columns = static_cast<std::uint32_t>(width),
+                          .rows = static_cast<std::uint32_t>(height) };
+
+        // Patterns are written top row first, the grid counts rows from the bottom.
+        for (std::size_t h{}; h < height; ++h)
+            for (std::size_t w{}; w < width; ++w) {
+                auto id{ toTileId(pattern[height - 1 - h][w]) };
+                if (id == map_file_water) continue;
+
+                auto tile{ (island.bounds.firstRow + h) * m_columns +
+                           island.bounds.firstColumn + w };
+                island.tiles.emplace_back(static_cast<std::uint32_t>(tile), id);
+            }
+    }
+
+    return islands;
+}
@@ -0,0 +1,58 @@
+#ifndef ENGINE_PREPARE_TO_GAME_MAP_BUILDER_HXX
+#define ENGINE_PREPARE_TO_GAME_MAP_BUILDER_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <structures.hxx>
+#include <utility>
+#include <vector>
+
+#include "map_format.hxx"
+
+// Builds a binary map from all island patterns at once. The patterns are parsed
+// in parallel, one group of islands per thread, then stamped into a dense grid of
+// tile ids from which the collision mask and the water spawns are collected in a
+// single pass, so the cost is linear in the map and island sizes. Used by the
+// game and by the map converter, so it depends on no engine code.
+class MapBuilder final
+{
+private:
+    struct IslandPattern
+    {
+        Position position{};
+        std::vector<std::string> pattern{};
+    };
+
+    struct IslandTiles
+    {
+        MapFileIsland bounds{};
+        // Tile index and tile id of every land tile.
+        std::vector<std::pair<std::uint32_t, std::uint8_t>> tiles{};
+    };
+
+    Size m_tileSize{};
+    std::size_t m_columns{};
+    std::size_t m_rows{};
+    Position m_gridOrigin{};
+
+    std::vector<IslandPattern> m_patterns{};
+
+public:
+    MapBuilder(Size tileSize, std::size_t columns, std::size_t rows, Position gridOrigin);
+
+    // The first row of the pattern is the top of the island, position its bottom left tile.
+    void addIsland(Position position, std::vector<std::string> pattern);
+    // Same with the bottom left tile given by its column and row.
+    void addIsland(std::size_t column, std::size_t row, std::vector<std::string> pattern);
+    // Image of a map file, see map_format.hxx.
+    [[nodiscard]] std::vector<std::byte> build() const;
+
+    [[nodiscard]] std::size_t getColumns() const noexcept;
+    [[nodiscard]] std::size_t getRows() const noexcept;
+
+private:
+    [[nodiscard]] std::vector<IslandTiles> parseIslands(std::size_t first, std::size_t last) const;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_MAP_BUILDER_HXX
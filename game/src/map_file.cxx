@@ -0,0 +1,125 @@
+#include "map_file.hxx"
+
+#include <bit>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <asset_registry.hxx>
+
+using namespace std::literals;
+
+static_assert(std::endian::native == std::endian::little, "map files are little-endian");
+
+MapFile::MapFile(const fs::path& path) {
+    if (auto file{ AssetRegistry::getInstance().findInPacks(path) })
+        m_data = *file;
+    else
+        m_data = m_file.emplace(path).getData();
+
+    validate();
+}
+
+MapFile::MapFile(std::vector<std::byte> image) : m_image{ std::move(image) } {
+    m_data = m_image;
+    validate();
+}
+
+const MapFileHeader& MapFile::getHeader() const noexcept { return *m_header; }
+
+std::span<const std::uint8_t> MapFile::getTiles() const noexcept {
+    return getSection<std::uint8_t>(m_header->tilesOffset,
+                                    std::size_t{ m_header->columns } * m_header->rows);
+}
+
+std::span<const std::uint64_t> MapFile::getCollision() const noexcept {
+    return getSection<std::uint64_t>(m_header->collisionOffset,
+                                     getCollisionStride(m_header->columns) * m_header->rows);
+}
+
+std::span<const MapFileIsland> MapFile::getIslands() const noexcept {
+    return getSection<MapFileIsland>(m_header->islandsOffset, m_header->islandCount);
+}
+
+std::span<const std::uint32_t> MapFile::getWaterSpawns() const noexcept {
+    return getSection<std::uint32_t>(m_header->waterSpawnsOffset, m_header->waterSpawnCount);
+}
+
+std::span<const std::uint32_t> MapFile::getLandSpawns() const noexcept {
+    return getSection<std::uint32_t>(m_header->landSpawnsOffset, m_header->landSpawnCount);
+}
+
+Size MapFile::getTileSize() const noexcept { return { m_header->tileWidth, m_header->tileHeight }; }
+
+Position MapFile::getTileCenter(std::uint32_t tile) const noexcept {
+    auto column{ tile % m_header->columns };
+    auto row{ tile / m_header->columns };
+
+    return { m_header->originX + m_header->tileWidth * (static_cast<float>(column) + 0.5f),
+             m_header->originY + m_header->tileHeight * (static_cast<float>(row) + 0.5f) };
+}
+
+void MapFile::validate() {
+    if (m_data.size() < sizeof(MapFileHeader))
+        throw std::runtime_error{ "Error : MapFile::validate : file is too small"s };
+
+    m_header = reinterpret_cast<const MapFileHeader*>(m_data.data());
+
+    if (m_header->magic != map_file_magic)
+        throw std::runtime_error{ "Error : MapFile::validate : not a map file"s };
+
+    if (m_header->version != map_file_version)
+        throw std::runtime_error{ "Error : MapFile::validate : unsupported version "s +
+                                  std::to_string(m_header->version) };
+
+    if (m_header->columns == 0 || m_header->rows == 0)
+        throw std::runtime_error{ "Error : MapFile::validate : empty grid"s };
+
+    auto tileCount{ std::uint64_t{ m_header->columns } * m_header->rows };
+    auto checkSection{ [this](std::uint64_t offset, std::uint64_t size, std::size_t alignment) {
+        if (offset % alignment != 0 || offset > m_data.size() || size > m_data.size() - offset)
+            throw std::runtime_error{ "Error : MapFile::validate : section is out of the file"s };
+    } };
+
+    checkSection(m_header->tilesOffset, tileCount, 1);
+    checkSection(m_header->collisionOffset,
+                 getCollisionStride(m_header->columns) * m_header->rows * sizeof(std::uint64_t),
+                 alignof(std::uint64_t));
+    checkSection(m_header->islandsOffset,
+                 std::uint64_t{ m_header->islandCount } * sizeof(MapFileIsland),
+                 alignof(MapFileIsland));
+    checkSection(m_header->waterSpawnsOffset,
+                 std::uint64_t{ m_header->waterSpawnCount } * sizeof(std::uint32_t),
+                 alignof(std::uint32_t));
+    checkSection(m_header->landSpawnsOffset,
+                 std::uint64_t{ m_header->landSpawnCount } * sizeof(std::uint32_t),
+                 alignof(std::uint32_t));
+
+    // Indices are checked once here so that readers can trust them.
+    for (const auto& island : getIslands()) {
+        if (std::uint64_t{ island.firstColumn } + island.columns > m_header->columns ||
+            std::uint64_t{ island.firstRow } + island.rows > m_header->rows)
+            throw std::runtime_error{ "Error : MapFile::validate : island is out of the grid"s };
+
+        if (std::uint64_t{ island.firstLandSpawn } + island.landSpawnCount >
+            m_header->landSpawnCount)
+            throw std::runtime_error{
+                "Error : MapFile::validate : island spawns are out of range"s
+            };
+    }
+
+    for (auto tile : getTiles())
+        if (tile > map_file_last_tile)
+            throw std::runtime_error{ "Error : MapFile::validate : unknown tile id "s +
+                                      std::to_string(tile) };
+
+    for (auto spawns : { getWaterSpawns(), getLandSpawns() })
+        for (auto tile : spawns)
+            if (tile >= tileCount)
+                throw std::runtime_error{ "Error : MapFile::validate : spawn is out of the grid"s };
+}
+
+template <typename T>
+std::span<const T> MapFile::getSection(std::uint64_t offset, std::size_t count) const noexcept {
+    return { reinterpret_cast<const T*>(m_data.data() + offset), count };
+}
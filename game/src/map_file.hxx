@@ -0,0 +1,50 @@
+#ifndef ENGINE_PREPARE_TO_GAME_MAP_FILE_HXX
+#define ENGINE_PREPARE_TO_GAME_MAP_FILE_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mapped_file.hxx>
+#include <optional>
+#include <span>
+#include <structures.hxx>
+#include <vector>
+
+#include "map_format.hxx"
+
+namespace fs = std::filesystem;
+
+// Binary map read in place: the file is mapped and every section is a span into
+// it, so loading only validates the offsets and indices, see map_format.hxx.
+class MapFile final
+{
+private:
+    std::optional<MappedFile> m_file{};
+    std::vector<std::byte> m_image{};
+    std::span<const std::byte> m_data{};
+    const MapFileHeader* m_header{};
+
+public:
+    // Reads the map in place from a mounted asset pack, or maps the file otherwise.
+    explicit MapFile(const fs::path& path);
+    // Takes a built image, see MapBuilder::build.
+    explicit MapFile(std::vector<std::byte> image);
+
+    [[nodiscard]] const MapFileHeader& getHeader() const noexcept;
+    [[nodiscard]] std::span<const std::uint8_t> getTiles() const noexcept;
+    [[nodiscard]] std::span<const std::uint64_t> getCollision() const noexcept;
+    [[nodiscard]] std::span<const MapFileIsland> getIslands() const noexcept;
+    [[nodiscard]] std::span<const std::uint32_t> getWaterSpawns() const noexcept;
+    [[nodiscard]] std::span<const std::uint32_t> getLandSpawns() const noexcept;
+
+    [[nodiscard]] Size getTileSize() const noexcept;
+    [[nodiscard]] Position getTileCenter(std::uint32_t tile) const noexcept;
+
+private:
+    void validate();
+    template <typename T>
+    [[nodiscard]] std::span<const T> getSection(std::uint64_t offset,
+                                                std::size_t count) const noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_MAP_FILE_HXX
@@ -0,0 +1,89 @@
+#ifndef ENGINE_PREPARE_TO_GAME_MAP_FORMAT_HXX
+#define ENGINE_PREPARE_TO_GAME_MAP_FORMAT_HXX
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Binary map files: a MapFileHeader followed by its sections, each starting at a
+// multiple of 8 bytes from the start of the file. Values are little-endian.
+//   tiles        columns * rows island tile ids, row by row from the bottom
+//   collision    rows of getCollisionStride(columns) words, bit c of word c / 64
+//                set when tile c of the row is land
+//   islands      MapFileIsland records
+//   water spawns tile indices row * columns + column of every water tile
+//   land spawns  tile indices of the land tiles of every island, island by island
+// MapBuilder writes them and MapFile reads them in place.
+
+inline constexpr std::array<char, 4> map_file_magic{ 'P', 'M', 'A', 'P' };
+inline constexpr std::uint32_t map_file_version{ 1 };
+
+// Tile id of water; land ids follow the island tileset order, see toTileId.
+inline constexpr std::uint8_t map_file_water{ 0 };
+// Highest tile id, the palm.
+inline constexpr std::uint8_t map_file_last_tile{ 5 };
+
+struct MapFileHeader
+{
+    std::array<char, 4> magic{};
+    std::uint32_t version{};
+    std::uint32_t columns{};
+    std::uint32_t rows{};
+    float tileWidth{};
+    float tileHeight{};
+    // World position of the corner of tile (0, 0).
+    float originX{};
+    float originY{};
+    std::uint32_t islandCount{};
+    std::uint32_t waterSpawnCount{};
+    std::uint32_t landSpawnCount{};
+    std::uint32_t reserved{};
+    std::uint64_t tilesOffset{};
+    std::uint64_t collisionOffset{};
+    std::uint64_t islandsOffset{};
+    std::uint64_t waterSpawnsOffset{};
+    std::uint64_t landSpawnsOffset{};
+};
+
+// Tiles covered by the pattern of an island and its range of the land spawns.
+struct MapFileIsland
+{
+    std::uint32_t firstColumn{};
+    std::uint32_t firstRow{};
+    std::uint32_t columns{};
+    std::uint32_t rows{};
+    std::uint32_t firstLandSpawn{};
+    std::uint32_t landSpawnCount{};
+};
+
+static_assert(sizeof(MapFileHeader) == 88);
+static_assert(sizeof(MapFileIsland) == 24);
+
+inline constexpr std::size_t getCollisionStride(std::size_t columns) noexcept {
+    return (columns + 63) / 64;
+}
+
+// Pattern characters: sand, sand with grass, grass, rocks and palm; anything else is water.
+inline constexpr std::uint8_t toTileId(char tile) noexcept {
+    switch (tile) {
+    case 'S':
+        return 1;
+    case 'B':
+        return 2;
+    case 'G':
+        return 3;
+    case 'R':
+        return 4;
+    case 'P':
+        return 5;
+    default:
+        return map_file_water;
+    }
+}
+
+inline constexpr char toTileChar(std::uint8_t id) noexcept {
+    constexpr std::array<char, map_file_last_tile + 1> tiles{ '#', 'S', 'B', 'G', 'R', 'P' };
+    return id < tiles.size() ? tiles[id] : '#';
+}
+
+#endif // ENGINE_PREPARE_TO_GAME_MAP_FORMAT_HXX
@@ -1,22 +1,26 @@
 #include "player.hxx"
 
+#include "config.hxx"
+
 Player::Player(const fs::path& texturePath, Size size)
-    : m_sprite{ size }, m_digAudio{ std::make_unique<Audio>("data/audio/dig.wav") } {
-    m_textures["back"][0].load("data/assets/pirate/back/back_standing.png");
-    m_textures["back"][1].load("data/assets/pirate/back/back_walking_a.png");
-    m_textures["back"][2].load("data/assets/pirate/back/back_walking_b.png");
-
-    m_textures["front"][0].load("data/assets/pirate/front/front_standing.png");
-    m_textures["front"][1].load("data/assets/pirate/front/front_walking_a.png");
-    m_textures["front"][2].load("data/assets/pirate/front/front_walking_b.png");
-
-    m_textures["left"][0].load("data/assets/pirate/left/left_standing.png");
-    m_textures["left"][1].load("data/assets/pirate/left/left_walking_a.png");
-    m_textures["left"][2].load("data/assets/pirate/left/left_walking_b.png");
-
-    m_textures["right"][0].load("data/assets/pirate/right/right_standing.png");
-    m_textures["right"][1].load("data/assets/pirate/right/right_walking_a.png");
-    m_textures["right"][2].load("data/assets/pirate/right/right_walking_b.png");
+    : m_digAudio{ AssetRegistry::getInstance().getAudio("data/audio/dig.wav") }, m_sprite{ size } {
+    // All animation frames share one atlas page, so the player never breaks a sprite batch.
+    AtlasBuilder builder{ 256, 256 };
+    for (const auto& direction : { "back"s, "front"s, "left"s, "right"s })
+        for (const auto& frame : { "standing"s, "walking_a"s, "walking_b"s })
+            builder.add(direction + "_" + frame,
+                        fs::path{ "data/assets/pirate" } / direction /
+                            (direction + "_" + frame + ".png"));
+
+    m_atlas = builder.build();
+
+    for (const auto& direction : { "back"s, "front"s, "left"s, "right"s }) {
+        m_textures[direction][0] = m_atlas.getTexture(direction + "_standing");
+        m_textures[direction][1] = m_atlas.getTexture(direction + "_walking_a");
+        m_textures[direction][2] = m_atlas.getTexture(direction + "_walking_b");
+    }
+
+    m_sprite.setLayer(Config::player_layer);
 }
 
 Sprite& Player::getSprite() noexcept { return m_sprite; }
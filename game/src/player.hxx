@@ -2,6 +2,8 @@
 #define ENGINE_PREPARE_TO_GAME_PLAYER_HXX
 
 #include <array>
+#include <asset_registry.hxx>
+#include <atlas.hxx>
 #include <audio.hxx>
 #include <memory>
 #include <sprite.hxx>
@@ -14,6 +16,7 @@ private:
     Position m_position{};
     Position m_lastPosition{};
 
+    Atlas m_atlas{};
     std::unordered_map<std::string, std::array<Texture, 3>> m_textures{};
     inline static constexpr float s_animBoost{ 8.0f };
     float m_animUpIndex{};
@@ -33,7 +36,7 @@ private:
 
     inline static constexpr float m_speed{ 35.0f };
 
-    std::unique_ptr<Audio> m_digAudio{};
+    std::shared_ptr<Audio> m_digAudio{};
 
     int m_money{};
 
@@ -2,8 +2,12 @@
 
 #include <algorithm>
 
+#include "config.hxx"
+
 Ship::Ship(const fs::path& textureFilepath, Size size, Player& player)
-    : m_sprite{ textureFilepath, size }, m_player{ player } {}
+    : m_sprite{ textureFilepath, size }, m_player{ player } {
+    m_sprite.setLayer(::Config::ship_layer);
+}
 
 void Ship::move() { m_isMove = true; }
 
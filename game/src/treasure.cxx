@@ -1,9 +1,14 @@
 #include "treasure.hxx"
 
+#include "config.hxx"
+
 Treasure::Treasure(const fs::path& treasureTexPath, const fs::path& xMarkTexPath, Size size)
     : m_treasureSprite{ treasureTexPath, size }
     , m_xMarkSprite{ xMarkTexPath, size }
-    , m_size{ size } {}
+    , m_size{ size } {
+    m_treasureSprite.setLayer(Config::treasure_layer);
+    m_xMarkSprite.setLayer(Config::x_mark_layer);
+}
 
 void Treasure::setPosition(Position position) {
     m_position = position;
@@ -0,0 +1,278 @@
+#include "world_streamer.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace std::literals;
+
+static Island makeIsland(const MapFile& file, const MapFileIsland& island) {
+    const auto& header{ file.getHeader() };
+    auto tiles{ file.getTiles() };
+
+    std::vector<std::pair<char, Position>> positions{};
+    positions.reserve(island.landSpawnCount);
+    for (auto tile : file.getLandSpawns().subspan(island.firstLandSpawn, island.landSpawnCount))
+        positions.emplace_back(toTileChar(tiles[tile]), file.getTileCenter(tile));
+
+    Rectangle rectangle{
+        .xy = { header.originX + header.tileWidth * static_cast<float>(island.firstColumn),
+                header.originY + header.tileHeight * static_cast<float>(island.firstRow) },
+        .wh = { header.tileWidth * static_cast<float>(island.columns),
+                header.tileHeight * static_cast<float>(island.rows) }
+    };
+
+    return { file.getTileSize(), rectangle, std::move(positions) };
+}
+
+WorldStreamer::WorldStreamer(const MapFile& file,
+                             std::shared_ptr<const Tileset> waterTileset,
+                             std::shared_ptr<const Tileset> islandTileset,
+                             std::size_t chunkSize,
+                             std::size_t memoryBudget)
+    : m_file{ file }
+    , m_waterTileset{ std::move(waterTileset) }
+    , m_islandTileset{ std::move(islandTileset) }
+    , m_chunkSize{ chunkSize }
+    , m_memoryBudget{ memoryBudget } {
+    if (m_chunkSize == 0)
+        throw std::runtime_error{ "Error : WorldStreamer::WorldStreamer : empty chunks"s };
+
+    const auto& header{ m_file.getHeader() };
+    m_chunkColumns = (header.columns + m_chunkSize - 1) / m_chunkSize;
+    m_chunkRows = (header.rows + m_chunkSize - 1) / m_chunkSize;
+
+    m_chunkIslands.resize(m_chunkColumns * m_chunkRows);
+    auto islands{ m_file.getIslands() };
+    for (std::size_t index{}; index < islands.size(); ++index) {
+        auto key{ islands[index].firstRow / m_chunkSize * m_chunkColumns +
+                  islands[index].firstColumn / m_chunkSize };
+        m_chunkIslands.at(key).push_back(static_cast<std::uint32_t>(index));
+    }
+
+    m_worker = std::thread{ &WorldStreamer::run, this };
+}
+
+WorldStreamer::~WorldStreamer() {
+    {
+        std::lock_guard lock{ m_mutex };
+        m_isStopping = true;
+    }
+
+    m_condition.notify_one();
+    m_worker.join();
+}
+
+bool WorldStreamer::update(const Rectangle& area) {
+    const auto& header{ m_file.getHeader() };
+    auto toChunk{ [this](float x, float origin, float tileSize, std::size_t count) {
+        auto chunk{ std::floor((x - origin) / tileSize / static_cast<float>(m_chunkSize)) };
+        return static_cast<std::size_t>(std::clamp(chunk, 0.0f, static_cast<float>(count - 1)));
+    } };
+
+    // Chunks covered by the area, inclusive.
+    auto firstColumn{ toChunk(area.xy.x, header.originX, header.tileWidth, m_chunkColumns) };
+    auto lastColumn{
+        toChunk(area.xy.x + area.wh.width, header.originX, header.tileWidth, m_chunkColumns)
+    };
+    auto firstRow{ toChunk(area.xy.y, header.originY, header.tileHeight, m_chunkRows) };
+    auto lastRow{
+        toChunk(area.xy.y + area.wh.height, header.originY, header.tileHeight, m_chunkRows)
+    };
+    auto centreColumn{ toChunk(
+        area.xy.x + area.wh.width / 2.0f, header.originX, header.tileWidth, m_chunkColumns) };
+    auto centreRow{ toChunk(
+        area.xy.y + area.wh.height / 2.0f, header.originY, header.tileHeight, m_chunkRows) };
+    auto centre{ centreRow * m_chunkColumns + centreColumn };
+
+    auto isInRange{ [&](std::size_t key, std::size_t margin) {
+        auto column{ key % m_chunkColumns };
+        auto row{ key / m_chunkColumns };
+        return column + margin >= firstColumn && column <= lastColumn + margin &&
+               row + margin >= firstRow && row <= lastRow + margin;
+    } };
+
+    bool isChanged{};
+
+    {
+        std::lock_guard lock{ m_mutex };
+        std::ranges::move(m_results, std::back_inserter(m_ready));
+        m_results.clear();
+    }
+
+    // The view must never show a hole where it is.
+    if (!m_chunks.contains(centre)) {
+        auto ready{ std::ranges::find(m_ready, centre, &ChunkData::key) };
+        if (ready != m_ready.end()) {
+            addChunk(std::move(*ready));
+            m_ready.erase(ready);
+        }
+        else
+            addChunk(buildChunk(centre));
+
+        isChanged = true;
+    }
+
+    for (std::size_t uploads{}; !m_ready.empty() && uploads < s_uploadsPerFrame;) {
+        auto data{ std::move(m_ready.front()) };
+        m_ready.pop_front();
+
+        // The view may have moved on while the chunk was built.
+        if (m_chunks.contains(data.key) || !isInRange(data.key, 2)) continue;
+
+        addChunk(std::move(data));
+        isChanged = true;
+        ++uploads;
+    }
+
+    // Chunks are loaded one chunk around the area, nearest first.
+    std::vector<std::size_t> missing{};
+    for (auto row{ firstRow > 0 ? firstRow - 1 : 0 }; row <= std::min(lastRow + 1, m_chunkRows - 1);
+         ++row)
+        for (auto column{ firstColumn > 0 ? firstColumn - 1 : 0 };
+             column <= std::min(lastColumn + 1, m_chunkColumns - 1);
+             ++column) {
+            auto key{ row * m_chunkColumns + column };
+            if (!m_chunks.contains(key) &&
+                std::ranges::find(m_ready, key, &ChunkData::key) == m_ready.end())
+                missing.push_back(key);
+        }
+
+    std::ranges::sort(
+        missing, std::less{}, [&](std::size_t key) { return getDistance(key, centre); });
+
+    {
+        // Requests that left the load area are dropped with the old queue.
+        std::lock_guard lock{ m_mutex };
+        m_requests.clear();
+        for (auto key : missing)
+            if (key != m_building) m_requests.push_back(key);
+    }
+
+    if (!missing.empty()) m_condition.notify_one();
+
+    // Chunks stay until they are two chunks away from the area, one more than they
+    // are loaded at, so moving back and forth over a border keeps them.
+    std::vector<std::size_t> evicted{};
+    for (const auto& [key, chunk] : m_chunks)
+        if (!isInRange(key, 2)) evicted.push_back(key);
+
+    if (m_memorySize > m_memoryBudget) {
+        std::vector<std::size_t> candidates{};
+        for (const auto& [key, chunk] : m_chunks)
+            if (isInRange(key, 2) && !isInRange(key, 1)) candidates.push_back(key);
+
+        std::ranges::sort(
+            candidates, std::greater{}, [&](std::size_t key) { return getDistance(key, centre); });
+
+        auto memorySize{ m_memorySize };
+        for (auto key : evicted)
+            memorySize -= m_chunks.at(key).memorySize;
+
+        for (auto key : candidates) {
+            if (memorySize <= m_memoryBudget) break;
+
+            memorySize -= m_chunks.at(key).memorySize;
+            evicted.push_back(key);
+        }
+    }
+
+    for (auto key : evicted)
+        evictChunk(key);
+
+    return isChanged || !evicted.empty();
+}
+
+std::unordered_map<std::size_t, WorldStreamer::Chunk>& WorldStreamer::getChunks() noexcept {
+    return m_chunks;
+}
+
+std::size_t WorldStreamer::getMemorySize() const noexcept { return m_memorySize; }
+
+void WorldStreamer::run() {
+    std::unique_lock lock{ m_mutex };
+
+    while (true) {
+        m_condition.wait(lock, [this] { return m_isStopping || !m_requests.empty(); });
+        if (m_isStopping) return;
+
+        auto key{ m_requests.front() };
+        m_requests.pop_front();
+        m_building = key;
+
+        lock.unlock();
+        auto data{ buildChunk(key) };
+        lock.lock();
+
+        m_results.push_back(std::move(data));
+        m_building = s_noChunk;
+    }
+}
+
+WorldStreamer::ChunkData WorldStreamer::buildChunk(std::size_t key) const {
+    const auto& header{ m_file.getHeader() };
+
+    ChunkData data{ .key = key,
+                    .firstColumn = key % m_chunkColumns * m_chunkSize,
+                    .firstRow = key / m_chunkColumns * m_chunkSize };
+    data.columns = std::min<std::size_t>(m_chunkSize, header.columns - data.firstColumn);
+    data.rows = std::min<std::size_t>(m_chunkSize, header.rows - data.firstRow);
+
+    // Rows of the chunk are copied out of the mapped grid.
+    auto tiles{ m_file.getTiles() };
+    data.tiles.resize(data.columns * data.rows);
+    for (std::size_t row{}; row < data.rows; ++row)
+        std::ranges::copy(
+            tiles.subspan((data.firstRow + row) * header.columns + data.firstColumn, data.columns),
+            data.tiles.begin() + static_cast<std::ptrdiff_t>(row * data.columns));
+
+    auto islands{ m_file.getIslands() };
+    data.islands.reserve(m_chunkIslands[key].size());
+    for (auto index : m_chunkIslands[key])
+        data.islands.push_back(makeIsland(m_file, islands[index]));
+
+    return data;
+}
+
+void WorldStreamer::addChunk(ChunkData&& data) {
+    Chunk chunk{ .firstColumn = data.firstColumn,
+                 .firstRow = data.firstRow,
+                 .water = std::make_unique<Tilemap>(data.columns, data.rows, m_waterTileset),
+                 .islands = std::make_unique<Tilemap>(data.columns, data.rows, m_islandTileset),
+                 .islandList = std::move(data.islands) };
+
+    chunk.water->fill(1);
+    chunk.water->upload();
+    chunk.islands->setTiles(data.tiles);
+    chunk.islands->upload();
+
+    // Both tilemaps keep their ids on the CPU and on the GPU.
+    chunk.memorySize = sizeof(Chunk) + data.tiles.size() * 4;
+    for (const auto& island : chunk.islandList)
+        chunk.memorySize +=
+            sizeof(Island) + island.getPositions().size() * sizeof(std::pair<char, Position>);
+
+    m_memorySize += chunk.memorySize;
+    m_chunks.insert_or_assign(data.key, std::move(chunk));
+}
+
+void WorldStreamer::evictChunk(std::size_t key) {
+    auto found{ m_chunks.find(key) };
+    if (found == m_chunks.end()) return;
+
+    m_memorySize -= found->second.memorySize;
+    m_chunks.erase(found);
+}
+
+std::size_t WorldStreamer::getDistance(std::size_t key, std::size_t centre) const noexcept {
+    auto columnDistance{ static_cast<std::ptrdiff_t>(key % m_chunkColumns) -
+                         static_cast<std::ptrdiff_t>(centre % m_chunkColumns) };
+    auto rowDistance{ static_cast<std::ptrdiff_t>(key / m_chunkColumns) -
+                      static_cast<std::ptrdiff_t>(centre / m_chunkColumns) };
+
+    return static_cast<std::size_t>(std::max(std::abs(columnDistance), std::abs(rowDistance)));
+}
@@ -0,0 +1,105 @@
+#ifndef ENGINE_PREPARE_TO_GAME_WORLD_STREAMER_HXX
+#define ENGINE_PREPARE_TO_GAME_WORLD_STREAMER_HXX
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tilemap.hxx>
+#include <unordered_map>
+#include <vector>
+#include <view.hxx>
+
+#include "island.hxx"
+#include "map_file.hxx"
+
+// Keeps the part of a map file around the view resident, split into square chunks
+// of tiles. Chunks near the view are built from the file on a background thread
+// and turned into tilemaps on the GL thread, a few per frame. Chunks are kept
+// until they are one chunk further away than the distance they are loaded at, so
+// sailing along a chunk border does not reload them, and the farthest ones past
+// the load distance are evicted early when the memory budget is exceeded.
+class WorldStreamer final
+{
+public:
+    struct Chunk
+    {
+        // Tile of the chunk's bottom left corner.
+        std::size_t firstColumn{};
+        std::size_t firstRow{};
+        std::unique_ptr<Tilemap> water{};
+        std::unique_ptr<Tilemap> islands{};
+        // Islands whose bottom left tile is inside the chunk.
+        std::vector<Island> islandList{};
+        std::size_t memorySize{};
+    };
+
+private:
+    struct ChunkData
+    {
+        std::size_t key{};
+        std::size_t firstColumn{};
+        std::size_t firstRow{};
+        std::size_t columns{};
+        std::size_t rows{};
+        std::vector<std::uint8_t> tiles{};
+        std::vector<Island> islands{};
+    };
+
+    inline static constexpr std::size_t s_noChunk{ static_cast<std::size_t>(-1) };
+    inline static constexpr std::size_t s_uploadsPerFrame{ 2 };
+
+    const MapFile& m_file;
+    std::shared_ptr<const Tileset> m_waterTileset{};
+    std::shared_ptr<const Tileset> m_islandTileset{};
+    std::size_t m_chunkSize{};
+    std::size_t m_chunkColumns{};
+    std::size_t m_chunkRows{};
+    std::size_t m_memoryBudget{};
+    std::size_t m_memorySize{};
+
+    // Island records by the chunk they belong to, read by the worker.
+    std::vector<std::vector<std::uint32_t>> m_chunkIslands{};
+    std::unordered_map<std::size_t, Chunk> m_chunks{};
+    // Built chunks waiting for their upload on the GL thread.
+    std::deque<ChunkData> m_ready{};
+
+    std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+    std::deque<std::size_t> m_requests{};
+    std::vector<ChunkData> m_results{};
+    std::size_t m_building{ s_noChunk };
+    bool m_isStopping{};
+    std::thread m_worker{};
+
+public:
+    WorldStreamer(const MapFile& file,
+                  std::shared_ptr<const Tileset> waterTileset,
+                  std::shared_ptr<const Tileset> islandTileset,
+                  std::size_t chunkSize,
+                  std::size_t memoryBudget);
+    ~WorldStreamer();
+
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    // Streams the chunks for the world area seen around the view, call it on the GL
+    // thread. The chunk under the centre of the area is built at once if missing.
+    // Returns whether the resident chunks changed.
+    bool update(const Rectangle& area);
+
+    [[nodiscard]] std::unordered_map<std::size_t, Chunk>& getChunks() noexcept;
+    [[nodiscard]] std::size_t getMemorySize() const noexcept;
+
+private:
+    void run();
+    [[nodiscard]] ChunkData buildChunk(std::size_t key) const;
+    void addChunk(ChunkData&& data);
+    void evictChunk(std::size_t key);
+    [[nodiscard]] std::size_t getDistance(std::size_t key, std::size_t centre) const noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_WORLD_STREAMER_HXX
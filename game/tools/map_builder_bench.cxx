@@ -0,0 +1,136 @@
+// Times MapBuilder::build over several map sizes and island counts, then
+// IslandGenerator::generate over the same sizes, and prints the median of a few
+// runs of each.
+//
+//     map_builder_bench [runs]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "island_generator.hxx"
+#include "map_builder.hxx"
+
+using namespace std::literals;
+
+// A diamond of sand around grass with a palm in the middle.
+static std::vector<std::string> makePattern(std::size_t size) {
+    std::vector<std::string> pattern(size, std::string(size, '#'));
+    auto centre{ static_cast<long>(size / 2) };
+
+    for (std::size_t row{}; row < size; ++row)
+        for (std::size_t column{}; column < size; ++column) {
+            auto distance{ std::abs(static_cast<long>(row) - centre) +
+                           std::abs(static_cast<long>(column) - centre) };
+            if (distance == 0)
+                pattern[row][column] = 'P';
+            else if (distance < centre)
+                pattern[row][column] = 'G';
+            else if (distance == centre)
+                pattern[row][column] = 'S';
+        }
+
+    return pattern;
+}
+
+static MapBuilder makeBuilder(std::size_t size, std::size_t islandCount) {
+    static constexpr std::size_t pattern_size{ 9 };
+
+    MapBuilder builder{ { 32.0f, 32.0f }, size, size, { 0.0f, 0.0f } };
+    auto pattern{ makePattern(pattern_size) };
+
+    // Islands on a regular lattice, overlapping when there are more than fit.
+    auto perRow{ std::max<std::size_t>(
+        static_cast<std::size_t>(std::sqrt(static_cast<double>(islandCount))), 1) };
+    auto span{ size - pattern_size };
+    auto step{ std::max<std::size_t>(span / perRow, 1) };
+
+    for (std::size_t i{}; i < islandCount; ++i)
+        builder.addIsland(i % perRow * step % span, i / perRow * step % span, pattern);
+
+    return builder;
+}
+
+static double measure(const MapBuilder& builder, std::size_t runs) {
+    std::vector<double> times{};
+
+    for (std::size_t run{}; run < runs; ++run) {
+        auto start{ std::chrono::steady_clock::now() };
+        auto image{ builder.build() };
+        std::chrono::duration<double, std::milli> elapsed{ std::chrono::steady_clock::now() -
+                                                           start };
+
+        if (image.empty()) throw std::runtime_error{ "Error : measure : empty map"s };
+        times.push_back(elapsed.count());
+    }
+
+    std::ranges::sort(times);
+    return times[times.size() / 2];
+}
+
+// Generation of a fresh builder each run, the last island count goes to islandCount.
+static double measureGeneration(std::size_t size, std::size_t runs, std::size_t& islandCount) {
+    std::vector<double> times{};
+
+    for (std::size_t run{}; run < runs; ++run) {
+        MapBuilder builder{ { 32.0f, 32.0f }, size, size, { 0.0f, 0.0f } };
+        IslandGenerator generator{ { .seed = run, .featureSize = 20.0f } };
+
+        auto start{ std::chrono::steady_clock::now() };
+        islandCount = generator.generate(builder);
+        std::chrono::duration<double, std::milli> elapsed{ std::chrono::steady_clock::now() -
+                                                           start };
+        times.push_back(elapsed.count());
+    }
+
+    std::ranges::sort(times);
+    return times[times.size() / 2];
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2) {
+        std::cerr << "usage: map_builder_bench [runs]\n"sv;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        std::size_t runs{ argc > 1 ? std::stoul(argv[1]) : 5 };
+        if (runs == 0) throw std::runtime_error{ "Error : main : no runs"s };
+
+        std::cout << std::setw(8) << "tiles"sv << std::setw(10) << "islands"sv << std::setw(12)
+                  << "build ms"sv << '\n';
+
+        for (std::size_t size : { 256, 1024, 4096 })
+            for (std::size_t islandCount : { 16, 256, 4096 }) {
+                auto builder{ makeBuilder(size, islandCount) };
+
+                std::cout << std::setw(8) << size << std::setw(10) << islandCount << std::setw(12)
+                          << std::fixed << std::setprecision(2) << measure(builder, runs) << '\n';
+            }
+
+        std::cout << '\n'
+                  << std::setw(8) << "tiles"sv << std::setw(10) << "islands"sv << std::setw(14)
+                  << "generate ms"sv << '\n';
+
+        for (std::size_t size : { 256, 1024, 4096 }) {
+            std::size_t islandCount{};
+            auto time{ measureGeneration(size, runs, islandCount) };
+
+            std::cout << std::setw(8) << size << std::setw(10) << islandCount << std::setw(14)
+                      << std::fixed << std::setprecision(2) << time << '\n';
+        }
+    }
+    catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
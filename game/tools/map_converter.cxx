@@ -0,0 +1,100 @@
+// Converts a text map with island patterns into a binary map file, see
+// data/maps/islands.txt for the input format and map_format.hxx for the output.
+//
+//     map_converter <input text map> <output binary map>
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "map_builder.hxx"
+
+namespace fs = std::filesystem;
+using namespace std::literals;
+
+static MapBuilder readTextMap(const fs::path& path) {
+    std::ifstream in{ path };
+    if (!in.is_open()) throw std::runtime_error{ "Error : readTextMap : bad open file"s };
+
+    std::unique_ptr<MapBuilder> builder{};
+    std::string line{};
+    std::size_t lineNumber{};
+
+    auto fail{ [&](std::string_view message) {
+        throw std::runtime_error{ "Error : readTextMap : line "s + std::to_string(lineNumber) +
+                                  " : "s + std::string{ message } };
+    } };
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        if (line.empty() || line.starts_with("//"sv)) continue;
+
+        std::istringstream words{ line };
+        std::string keyword{};
+        words >> keyword;
+
+        if (keyword == "map"sv) {
+            std::size_t columns{};
+            std::size_t rows{};
+            Size tileSize{};
+            Position origin{};
+            if (!(words >> columns >> rows >> tileSize.width >> tileSize.height >> origin.x >>
+                  origin.y))
+                fail("expected map <columns> <rows> <tile width> <tile height> "
+                     "<origin x> <origin y>"sv);
+
+            builder = std::make_unique<MapBuilder>(tileSize, columns, rows, origin);
+        }
+        else if (keyword == "island"sv) {
+            if (!builder) fail("island before map"sv);
+
+            Position position{};
+            if (!(words >> position.x >> position.y)) fail("expected island <x> <y>"sv);
+
+            // Pattern rows run up to the next empty line.
+            std::vector<std::string> pattern{};
+            while (std::getline(in, line) && !line.empty()) {
+                ++lineNumber;
+                pattern.push_back(line);
+            }
+            ++lineNumber;
+
+            builder->addIsland(position, std::move(pattern));
+        }
+        else
+            fail("unknown keyword "s + keyword);
+    }
+
+    if (!builder) throw std::runtime_error{ "Error : readTextMap : no map line"s };
+
+    return std::move(*builder);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "usage: map_converter <input text map> <output binary map>\n"sv;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        auto image{ readTextMap(argv[1]).build() };
+
+        std::ofstream out{ argv[2], std::ios::binary };
+        out.write(reinterpret_cast<const char*>(image.data()),
+                  static_cast<std::streamsize>(image.size()));
+        if (!out) throw std::runtime_error{ "Error : main : can't write "s + argv[2] };
+    }
+    catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}